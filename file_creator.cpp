@@ -1,26 +1,15 @@
-#include <iostream>
-#include <fstream>
-#include <string>
-#include <vector>
-#include <iomanip>
-#include <chrono>
-#include <sstream>
-#include <thread>
-#include <mutex>
-#include <atomic>
-#include <algorithm>
-#include <cmath>
-#include <memory>
+#include "file_creator_engine.hpp"
 
 #ifdef _WIN32
-#include <windows.h>
+#include <sys/stat.h>
 #ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
 #define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
 #endif
 #endif
 
 using namespace std;
-using namespace chrono;
+using namespace std::chrono;
+using namespace turbo;
 
 // ANSI Escape Codes
 namespace ANSI {
@@ -32,15 +21,15 @@ namespace ANSI {
     const string SAVE_CURSOR = "\033[s";
     const string RESTORE_CURSOR = "\033[u";
     
-    string moveCursor(int row, int col) {
+    inline string moveCursor(int row, int col) {
         return "\033[" + to_string(row) + ";" + to_string(col) + "H";
     }
     
-    string moveUp(int lines) {
+    inline string moveUp(int lines) {
         return "\033[" + to_string(lines) + "A";
     }
     
-    string moveDown(int lines) {
+    inline string moveDown(int lines) {
         return "\033[" + to_string(lines) + "B";
     }
 }
@@ -82,39 +71,11 @@ namespace Color {
     const string BG_BRIGHT_CYAN = "\033[106m";
 }
 
-// Advanced Statistics
-struct AdvancedStats {
-    atomic<long long> totalBytes{0};
-    atomic<double> peakSpeed{0};
-    atomic<long long> operationCount{0};
-    vector<double> speedSamples;
-    mutex statsMutex;
-    double avgSpeed = 0;
-    double efficiency = 0;
-    
-    void recordSpeed(double speed) {
-        lock_guard<mutex> lock(statsMutex);
-        speedSamples.push_back(speed);
-        
-        double peak = peakSpeed.load();
-        while (speed > peak && !peakSpeed.compare_exchange_weak(peak, speed));
-        
-        if (!speedSamples.empty()) {
-            double sum = 0;
-            int samples = min(static_cast<int>(speedSamples.size()), 50);
-            for (int i = speedSamples.size() - samples; i < speedSamples.size(); i++) {
-                sum += speedSamples[i];
-            }
-            avgSpeed = sum / samples;
-        }
-    }
-};
-
 // Display Manager - Prevents stacking
 class DisplayManager {
 private:
-    int progressLine = 0;
     bool isInitialized = false;
+    bool lineOpen = false;
     mutex displayMutex;
     
 public:
@@ -137,83 +98,37 @@ public:
     void clearProgress() {
         lock_guard<mutex> lock(displayMutex);
         cout << "\r" << ANSI::CLEAR_LINE << flush;
+        lineOpen = false;
     }
     
     void updateProgress(const string& content) {
         lock_guard<mutex> lock(displayMutex);
         cout << "\r" << ANSI::CLEAR_LINE << content << flush;
+        lineOpen = true;
     }
     
     void newLine() {
         lock_guard<mutex> lock(displayMutex);
         cout << "\n";
+        lineOpen = false;
     }
-};
-
-// Turbocharged File Creator
-class TurboFileCreator {
-private:
-    string fileName;
-    long long fileSize;
-    int numThreads;
-    int bufferSizeMB;
     
-    atomic<long long> bytesWritten{0};
-    atomic<bool> errorFlag{false};
-    atomic<int> activeWorkers{0};
-    
-    AdvancedStats stats;
-    DisplayManager display;
-    bool useRandomData;
-    bool turboMode;
-    
-    void setupConsole() {
-        #ifdef _WIN32
-        SetConsoleOutputCP(CP_UTF8);
-        SetConsoleCP(CP_UTF8);
-        
-        HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
-        if (hOut != INVALID_HANDLE_VALUE) {
-            DWORD dwMode = 0;
-            if (GetConsoleMode(hOut, &dwMode)) {
-                dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
-                SetConsoleMode(hOut, dwMode);
-            }
-        }
-        #endif
-    }
-
-    string formatBytes(long long bytes) const {
-        const char* units[] = {"B", "KB", "MB", "GB", "TB", "PB"};
-        int idx = 0;
-        double size = static_cast<double>(bytes);
-        
-        while (size >= 1024.0 && idx < 5) {
-            size /= 1024.0;
-            idx++;
-        }
-        
-        stringstream ss;
-        ss << fixed << setprecision(2) << size << " " << units[idx];
-        return ss.str();
+    // Leaves the last progress line on screen so a message can follow it
+    void endLine() {
+        lock_guard<mutex> lock(displayMutex);
+        if (lineOpen) cout << "\n";
+        lineOpen = false;
     }
+};
 
-    string formatDuration(double seconds) const {
-        if (seconds < 0.001) return to_string(static_cast<int>(seconds * 1000000)) + " μs";
-        if (seconds < 1.0) return to_string(static_cast<int>(seconds * 1000)) + " ms";
-        if (seconds < 60.0) {
-            stringstream ss;
-            ss << fixed << setprecision(3) << seconds << " sec";
-            return ss.str();
-        }
-        if (seconds < 3600.0) {
-            return to_string(static_cast<int>(seconds / 60)) + "m " + 
-                   to_string(static_cast<int>(seconds) % 60) + "s";
-        }
-        return to_string(static_cast<int>(seconds / 3600)) + "h " + 
-               to_string(static_cast<int>(seconds / 60) % 60) + "m";
-    }
+namespace turbo {
 
+// Terminal Dashboard
+// Banner, configuration panel, progress line and result panels, drawn through RunView
+class Dashboard : public RunView {
+private:
+    DisplayManager display;
+    
     string getSpeedIndicator(double currentSpeed, double avgSpeed) const {
         double ratio = avgSpeed > 0 ? currentSpeed / avgSpeed : 1.0;
         
@@ -270,11 +185,302 @@ private:
         return spark.str();
     }
 
-    void displayProgress(long long current, long long total, double elapsed) {
-        float progress = static_cast<float>(current) / static_cast<float>(total);
-        double currentSpeed = elapsed > 0 ? current / elapsed : 0;
+    // Writer counts the controller tried, in order
+    string adaptiveTrail(const TurboFileCreator& run) const {
+        const auto& decisions = run.controller.decisions();
+        string trail = "1";
+        for (const auto& decision : decisions) trail += " → " + to_string(decision.to);
+        return trail;
+    }
+
+    void showConfig(const TurboFileCreator& run) {
+        cout << Color::BRIGHT_WHITE << "  ╭─ " << Color::BRIGHT_CYAN << "⚙ CONFIGURATION" << Color::BRIGHT_WHITE << " ──────────────────────────────────────────────╮\n" << Color::RESET;
+        cout << Color::BRIGHT_WHITE << "  │\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "📁 Target File    : " << Color::BRIGHT_GREEN << run.targetName() << Color::RESET << "\n";
+        if (!run.options.stripeTargets.empty()) {
+            cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🧱 Stripe Set     : " << Color::BRIGHT_CYAN << run.stripeWidth() << " targets, "
+                 << run.formatBytes(run.options.stripeUnit) << " units" << Color::BRIGHT_BLACK << " (" << run.stripeThreads() << " workers each)" << Color::RESET << "\n";
+            for (int t = 1; t < run.stripeWidth(); t++) {
+                cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_BLACK << "                     + " << Color::BRIGHT_GREEN << run.options.stripeTargets[t - 1] << Color::RESET << "\n";
+            }
+        }
+        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "📏 File Size      : " << Color::BRIGHT_YELLOW
+             << (run.options.unbounded ? string("Unbounded (until the reader stops or Ctrl-C)") : run.formatBytes(run.fileSize)) << Color::RESET << "\n";
+        if (run.batch) {
+            cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "📄 Batch Files    : " << Color::BRIGHT_YELLOW << run.batch->count()
+                 << Color::BRIGHT_BLACK << (run.batch->manifest.empty() ? " (generated)" : " (manifest)") << Color::RESET << "\n";
+        }
+        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "💾 Buffer Size    : " << Color::BRIGHT_BLUE << run.bufferSizeMB << " MB per thread" << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🧩 Work Unit      : " << Color::BRIGHT_BLUE << run.formatBytes(run.chunkUnit(run.fileSize / run.stripeWidth(), run.writerCount() / run.stripeWidth())) << " (dynamic)" << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🔥 Thread Count   : " << Color::BRIGHT_MAGENTA << (run.options.adaptive ? "1 to " : "") << run.writerCount() << " workers"
+             << Color::BRIGHT_BLACK << (run.options.adaptive ? " (adaptive)" : "") << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🛠 Write Engine   : " << Color::BRIGHT_CYAN << run.backendName() << Color::RESET << "\n";
+        showTopology(run);
+        if (run.options.cloneSeed > 0) {
+            cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🧬 Clone Mode     : " << Color::BRIGHT_CYAN << run.formatBytes(run.options.cloneSeed) << " seed"
+                 << Color::BRIGHT_BLACK << " (reflink → copy_file_range → rewrite)" << Color::RESET << "\n";
+        }
+        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "📦 Pre-allocation : " << Color::BRIGHT_CYAN << run.preallocName(run.options.prealloc) << (run.options.allocateOnly ? " (metadata only)" : "") << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🎯 Rate Limit     : ";
+        if (run.limiter.enabled()) {
+            cout << Color::BRIGHT_GREEN << (run.limiter.scheduled() ? "step schedule" : run.formatBytes(static_cast<long long>(run.options.rateLimit)) + "/s")
+                 << Color::BRIGHT_BLACK << " (burst " << run.formatBytes(static_cast<long long>(run.limiter.burst()));
+            if (run.limiter.ramp() > 0) cout << ", ramp " << run.formatDuration(run.limiter.ramp());
+            cout << ")";
+        } else {
+            cout << Color::BRIGHT_CYAN << "Unlimited";
+        }
+        cout << Color::RESET << "\n";
+        if (!run.options.checkpointPath.empty()) {
+            cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "↻ Checkpoint     : " << Color::BRIGHT_CYAN << run.options.checkpointPath
+                 << Color::BRIGHT_BLACK << (run.options.resume ? " (resuming)" : "") << Color::RESET << "\n";
+        }
+        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🧊 Cache Mode     : " << (run.options.directIO ? Color::BRIGHT_GREEN + "Direct I/O (page cache bypassed)" : Color::BRIGHT_YELLOW + "Buffered (page cache)") << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🎨 Data Pattern   : ";
+        if (run.useRandomData) {
+            cout << Color::BRIGHT_GREEN << "Random" << Color::BRIGHT_BLACK << " (xoshiro256+ " << run.generator.isaName()
+                 << ", seed 0x" << hex << run.generator.seedValue() << dec << ")";
+            if (run.generator.shaped()) {
+                cout << "\n" << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🗜 Reduction      : " << Color::BRIGHT_CYAN << fixed << setprecision(2)
+                     << run.options.compressRatio << "x compress, " << run.options.dedupRatio << "x dedup" << Color::BRIGHT_BLACK << " (" << run.formatBytes(run.options.dedupBlock) << " chunks)";
+            }
+        } else {
+            cout << Color::BRIGHT_CYAN << "Zero-filled";
+        }
+        cout << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "⚡ Turbo Mode     : " << (run.turboMode ? Color::BRIGHT_GREEN + "ENABLED ✓" : Color::YELLOW + "Standard") << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🚀 Optimization   : " << Color::BRIGHT_CYAN << "Maximum Performance" << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │\n";
+        cout << "  ╰───────────────────────────────────────────────────────────────────╯\n";
+        cout << Color::RESET << "\n";
+    }
+
+    // Where the writers run: pinned CPUs with their NUMA nodes, buffer placement and priorities
+    void showTopology(const TurboFileCreator& run) {
+        int nodes = CpuTopology::nodeCount();
+        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🧭 CPU Placement  : ";
+        if (run.options.cpus.empty()) {
+            cout << Color::BRIGHT_CYAN << "Unpinned" << Color::BRIGHT_BLACK << " (" << CpuTopology::allowed().size() << " CPUs";
+        } else {
+            vector<int> usedNodes;
+            for (int cpu : run.options.cpus) {
+                int node = CpuTopology::nodeOf(cpu);
+                if (find(usedNodes.begin(), usedNodes.end(), node) == usedNodes.end()) usedNodes.push_back(node);
+            }
+            sort(usedNodes.begin(), usedNodes.end());
+            cout << Color::BRIGHT_GREEN << "CPUs " << CpuTopology::format(run.options.cpus)
+                 << Color::BRIGHT_BLACK << " (round-robin, node" << (usedNodes.size() > 1 ? "s " : " ") << CpuTopology::format(usedNodes);
+        }
+        cout << " of " << nodes << " NUMA node" << (nodes > 1 ? "s" : "") << ")" << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🧠 Buffer Memory  : " << Color::BRIGHT_CYAN
+             << (run.options.numaLocal ? "Local to each writer's node" : "Default policy") << Color::RESET << "\n";
+        if (run.options.ioprioClass != 0 || run.options.niceness != 0) {
+            cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🚦 Priority       : " << Color::BRIGHT_CYAN << "I/O " << run.ioprioName(run.options.ioprioClass, run.options.ioprioLevel)
+                 << Color::BRIGHT_BLACK << " │ " << Color::BRIGHT_CYAN << "nice " << (run.options.niceness > 0 ? "+" : "") << run.options.niceness << Color::RESET << "\n";
+        }
+    }
+
+    string formatLatency(const TurboFileCreator& run, uint64_t nanos) const {
+        if (nanos < 1000) return to_string(nanos) + " ns";
+        if (nanos < 1000000) {
+            stringstream ss;
+            ss << fixed << setprecision(1) << nanos / 1000.0 << " μs";
+            return ss.str();
+        }
+        if (nanos < 1000000000ULL) {
+            stringstream ss;
+            ss << fixed << setprecision(2) << nanos / 1000000.0 << " ms";
+            return ss.str();
+        }
+        return run.formatDuration(nanos / 1e9);
+    }
+
+    void showLatencyStats(const TurboFileCreator& run) {
+        LatencyHistogram merged;
+        run.mergeLatency(merged);
+        if (merged.count() == 0) return;
+        
+        cout << "  │  " << Color::BRIGHT_WHITE << "⏱ Write Latency     : "
+             << Color::BRIGHT_BLACK << "p50 " << Color::BRIGHT_GREEN << formatLatency(run, merged.percentile(50))
+             << Color::BRIGHT_BLACK << " │ p99 " << Color::BRIGHT_YELLOW << formatLatency(run, merged.percentile(99))
+             << Color::BRIGHT_BLACK << " │ p99.9 " << Color::BRIGHT_RED << formatLatency(run, merged.percentile(99.9))
+             << Color::BRIGHT_BLACK << " │ max " << Color::BRIGHT_MAGENTA << formatLatency(run, merged.maximum())
+             << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_BLACK << "   " << merged.count() << " writes sampled" << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │\n";
+    }
+
+    // Bytes each worker pulled from the scheduler; a long bar next to short ones marks a fast region
+    void showWorkerBalance(const TurboFileCreator& run) {
+        if (run.workerStatsCount == 0) return;
+        
+        long long minBytes, maxBytes;
+        double balance = run.loadBalance(minBytes, maxBytes);
+        
+        cout << "  │  " << Color::BRIGHT_WHITE << "⚖ Load Balance      : ";
+        if (balance > 85) cout << Color::BRIGHT_GREEN;
+        else if (balance > 60) cout << Color::BRIGHT_YELLOW;
+        else cout << Color::BRIGHT_RED;
+        cout << fixed << setprecision(1) << balance << "%" << Color::BRIGHT_BLACK
+             << " (" << (run.batch ? to_string(run.scheduler.unit()) + "-file" : run.formatBytes(run.scheduler.unit())) << " units)" << Color::RESET << "\n";
+        
+        // Listing every worker stops being readable past a screenful
+        if (run.workerStatsCount > 16) {
+            cout << "  │  " << Color::BRIGHT_BLACK << "   min " << run.formatBytes(minBytes) << " / max " << run.formatBytes(maxBytes) << " per worker" << Color::RESET << "\n";
+        } else {
+            for (int i = 0; i < run.workerStatsCount; i++) {
+                long long bytes = run.workerStats[i].bytes.load();
+                int width = maxBytes > 0 ? static_cast<int>(20.0 * bytes / maxBytes) : 0;
+                
+                cout << "  │  " << Color::BRIGHT_BLACK << "   W" << setw(2) << setfill('0') << i << setfill(' ') << " " << Color::BRIGHT_CYAN;
+                for (int b = 0; b < 20; b++) cout << (b < width ? "█" : "░");
+                cout << " " << Color::WHITE << run.formatBytes(bytes) << Color::BRIGHT_BLACK << " (" << run.workerStats[i].units.load() << (run.batch ? " files)" : " units)") << Color::RESET << "\n";
+            }
+        }
+        
+        cout << Color::BRIGHT_WHITE << "  │\n";
+    }
+
+    // Small-file metrics: at a few KB per file, open/close and directory work dominate the byte rate
+    void showBatchStats(const TurboFileCreator& run, double totalTime) {
+        LatencyHistogram opens, closes;
+        double openPct, writePct, closePct;
+        run.batchPhaseShares(opens, closes, openPct, writePct, closePct);
+        long long files = run.filesCreated();
         
-        stats.recordSpeed(currentSpeed);
+        cout << "  │  " << Color::BRIGHT_WHITE << "📄 Files Created     : " << Color::BRIGHT_GREEN << files
+             << Color::BRIGHT_BLACK << " (" << fixed << setprecision(0) << (totalTime > 0 ? files / totalTime : 0) << " files/s)" << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "📁 Directories       : " << Color::BRIGHT_CYAN << run.directoriesCreated
+             << Color::BRIGHT_BLACK << " created in " << run.formatDuration(run.mkdirTime) << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "⏱ Open (create)     : "
+             << Color::BRIGHT_BLACK << "p50 " << Color::BRIGHT_GREEN << formatLatency(run, opens.percentile(50))
+             << Color::BRIGHT_BLACK << " │ p99 " << Color::BRIGHT_YELLOW << formatLatency(run, opens.percentile(99))
+             << Color::BRIGHT_BLACK << " │ " << fixed << setprecision(1) << openPct << "% of I/O time" << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "⏱ Close             : "
+             << Color::BRIGHT_BLACK << "p50 " << Color::BRIGHT_GREEN << formatLatency(run, closes.percentile(50))
+             << Color::BRIGHT_BLACK << " │ p99 " << Color::BRIGHT_YELLOW << formatLatency(run, closes.percentile(99))
+             << Color::BRIGHT_BLACK << " │ " << fixed << setprecision(1) << closePct << "% of I/O time" << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "⏱ Data Writes       : " << Color::BRIGHT_BLACK << fixed << setprecision(1) << writePct << "% of I/O time" << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │\n";
+    }
+
+    // One line per stripe target; the slowest is the one to look at in a JBOD
+    void showStripeStats(const TurboFileCreator& run) {
+        int slowest = -1;
+        double slowestRate = 0;
+        for (size_t i = 0; i < run.stripes.size(); i++) {
+            const TurboFileCreator& member = *run.stripes[i]->creator;
+            double rate = member.committedSpeed(member.writeTime);
+            if (member.fileSize > 0 && (slowest < 0 || rate < slowestRate)) {
+                slowest = static_cast<int>(i);
+                slowestRate = rate;
+            }
+        }
+        
+        cout << "  │  " << Color::BRIGHT_WHITE << "🧱 Stripe Targets    : " << Color::BRIGHT_CYAN << run.stripes.size() << " × " << run.formatBytes(run.options.stripeUnit) << " units" << Color::RESET << "\n";
+        for (size_t i = 0; i < run.stripes.size(); i++) {
+            const TurboFileCreator& member = *run.stripes[i]->creator;
+            cout << "  │  " << Color::BRIGHT_BLACK << "   T" << i << " " << (static_cast<int>(i) == slowest ? Color::BRIGHT_RED : Color::BRIGHT_GREEN)
+                 << setw(10) << run.formatBytes(static_cast<long long>(member.committedSpeed(member.writeTime))) << "/s"
+                 << Color::BRIGHT_BLACK << " │ " << Color::WHITE << run.formatBytes(member.fileSize) << Color::BRIGHT_BLACK << " in " << run.formatDuration(member.writeTime + member.flushTime)
+                 << " │ " << member.fileName;
+            if (run.options.verifyAfterWrite) cout << (run.stripes[i]->verified ? Color::BRIGHT_GREEN + " ✓" : Color::BRIGHT_RED + " ✗");
+            cout << Color::RESET << "\n";
+        }
+        cout << Color::BRIGHT_WHITE << "  │\n";
+    }
+
+    void showStageUtilization(const TurboFileCreator& run, double totalTime) {
+        double generatePct, writePct;
+        string bound;
+        if (!run.stageUtilization(totalTime, generatePct, writePct, bound)) return;
+        
+        cout << "  │  " << Color::BRIGHT_WHITE << "🔀 Pipeline          : " << Color::BRIGHT_CYAN
+             << (run.pipelined() ? to_string(run.options.pipelineDepth) + " buffers/writer" : string("sequential"))
+             << Color::BRIGHT_BLACK << " │ generate " << Color::BRIGHT_YELLOW << fixed << setprecision(0) << generatePct << "%"
+             << Color::BRIGHT_BLACK << " │ write " << Color::BRIGHT_GREEN << writePct << "%"
+             << Color::BRIGHT_BLACK << " → " << (bound == "CPU-bound" ? Color::BRIGHT_RED : Color::BRIGHT_GREEN) << bound << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │\n";
+    }
+
+    void showOpStats(const TurboFileCreator& run, const string& label, const LatencyHistogram& latency, long long bytes, double totalTime) {
+        if (latency.count() == 0) return;
+        double iops = totalTime > 0 ? latency.count() / totalTime : 0;
+        cout << "  │  " << Color::BRIGHT_WHITE << label << Color::BRIGHT_YELLOW << fixed << setprecision(0) << iops << " IOPS"
+             << Color::BRIGHT_BLACK << " │ " << Color::BRIGHT_CYAN << run.formatBytes(static_cast<long long>(totalTime > 0 ? bytes / totalTime : 0)) << "/s"
+             << Color::BRIGHT_BLACK << " │ " << latency.count() << " ops" << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_BLACK << "   avg " << Color::WHITE << formatLatency(run, latency.sum() / latency.count())
+             << Color::BRIGHT_BLACK << " │ p50 " << Color::BRIGHT_GREEN << formatLatency(run, latency.percentile(50))
+             << Color::BRIGHT_BLACK << " │ p99 " << Color::BRIGHT_YELLOW << formatLatency(run, latency.percentile(99))
+             << Color::BRIGHT_BLACK << " │ p99.9 " << Color::BRIGHT_RED << formatLatency(run, latency.percentile(99.9))
+             << Color::BRIGHT_BLACK << " │ max " << Color::BRIGHT_MAGENTA << formatLatency(run, latency.maximum()) << Color::RESET << "\n";
+    }
+
+public:
+    static void showBanner() {
+        cout << "\n";
+        cout << Color::BOLD << Color::BRIGHT_CYAN;
+        cout << "  ╔═══════════════════════════════════════════════════════════════════════╗\n";
+        cout << "  ║                                                                       ║\n";
+        cout << "  ║           " << Color::BRIGHT_WHITE << "⚡⚡⚡ TURBO FILE CREATOR " << Color::BRIGHT_YELLOW << "v5.1 " << Color::BRIGHT_WHITE << "⚡⚡⚡" << Color::BRIGHT_CYAN << "              ║\n";
+        cout << "  ║                                                                       ║\n";
+        cout << "  ║     " << Color::BRIGHT_GREEN << "Ultra-Fast" << Color::BRIGHT_BLACK << " • " 
+             << Color::BRIGHT_MAGENTA << "Multi-Threaded" << Color::BRIGHT_BLACK << " • "
+             << Color::BRIGHT_YELLOW << "Optimized I/O" << Color::BRIGHT_BLACK << " • "
+             << Color::BRIGHT_CYAN << "Pro Stats" << Color::BRIGHT_CYAN << "     ║\n";
+        cout << "  ║                                                                       ║\n";
+        cout << "  ╚═══════════════════════════════════════════════════════════════════════╝\n";
+        cout << Color::RESET << "\n";
+    }
+
+    void configured(const TurboFileCreator& run) override {
+        showBanner();
+        showConfig(run);
+    }
+
+    void workloadConfigured(const TurboFileCreator& run, double limit) override {
+        showBanner();
+        cout << Color::BRIGHT_WHITE << "  ╭─ " << Color::BRIGHT_CYAN << "⚙ WORKLOAD" << Color::BRIGHT_WHITE << " ───────────────────────────────────────────────────╮\n" << Color::RESET;
+        cout << Color::BRIGHT_WHITE << "  │\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "📁 Target File    : " << Color::BRIGHT_GREEN << run.fileName << Color::BRIGHT_BLACK << " (" << run.formatBytes(run.fileSize) << ")" << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "🔀 Mix            : " << Color::BRIGHT_YELLOW << run.options.readPercent << "% read / " << (100 - run.options.readPercent) << "% write" << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "📏 Block Size     : " << Color::BRIGHT_BLUE << run.formatBytes(run.options.blockSize) << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "🎲 Offsets        : " << Color::BRIGHT_CYAN << run.distributionName(run.options.distribution, run.options.zipfTheta) << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "⏱ Stop After     : " << Color::BRIGHT_CYAN;
+        if (run.options.opLimit > 0) cout << run.options.opLimit << " ops";
+        if (run.options.opLimit > 0 && limit > 0) cout << " or ";
+        if (limit > 0) cout << run.formatDuration(limit);
+        cout << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "🔥 Thread Count   : " << Color::BRIGHT_MAGENTA << run.numThreads << " workers" << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "🧊 Cache Mode     : " << (run.options.directIO ? Color::BRIGHT_GREEN + "Direct I/O (page cache bypassed)" : Color::BRIGHT_YELLOW + "Buffered (page cache)") << Color::RESET << "\n";
+        showTopology(run);
+        cout << Color::BRIGHT_WHITE << "  │\n";
+        cout << "  ╰───────────────────────────────────────────────────────────────────╯\n";
+    }
+
+    void verifyConfigured(const TurboFileCreator&) override {
+        showBanner();
+    }
+
+    void initializing(const TurboFileCreator& run) override {
+        cout << Color::BRIGHT_CYAN << (run.batch ? "  ⚡ Initializing batch creation...\n" : "  ⚡ Initializing turbo file creation...\n") << Color::RESET;
+        cout << Color::BRIGHT_BLACK << "  ═══════════════════════════════════════════════════════════════════\n" << Color::RESET;
+        cout << "\n";
+    }
+
+    void running(const TurboFileCreator&) override {
+        display.initialize();
+    }
+
+    void stopped(const TurboFileCreator&) override {
+        display.cleanup();
+    }
+
+    void progress(const TurboFileCreator& run, long long current, long long total, double elapsed) override {
+        // An unbounded stream has no total: the bar stays empty and the percentage reads ∞
+        bool open = run.options.unbounded && total <= 0;
+        float progress = total > 0 ? static_cast<float>(current) / static_cast<float>(total) : (open ? 0.0f : 1.0f);
+        double currentSpeed = elapsed > 0 ? (current - run.resumedBytes) / elapsed : 0;
         
         stringstream output;
         
@@ -288,72 +494,130 @@ private:
         if (progress < 0.33) output << Color::BRIGHT_RED;
         else if (progress < 0.66) output << Color::BRIGHT_YELLOW;
         else output << Color::BRIGHT_GREEN;
-        output << Color::BOLD << setw(6) << fixed << setprecision(2) << (progress * 100.0) << "%" << Color::RESET;
+        if (open) output << Color::BOLD << "     ∞ " << Color::RESET;
+        else output << Color::BOLD << setw(6) << fixed << setprecision(2) << (progress * 100.0) << "%" << Color::RESET;
         
         // Data transferred
         output << Color::BRIGHT_WHITE << " │ " << Color::RESET;
-        output << Color::BRIGHT_CYAN << formatBytes(current) << Color::RESET;
-        output << Color::BRIGHT_BLACK << "/" << Color::RESET;
-        output << Color::WHITE << formatBytes(total) << Color::RESET;
+        output << Color::BRIGHT_CYAN << run.formatBytes(current) << Color::RESET;
+        if (!open) {
+            output << Color::BRIGHT_BLACK << "/" << Color::RESET;
+            output << Color::WHITE << run.formatBytes(total) << Color::RESET;
+        }
         
         if (elapsed > 0.05) {
             // Speed
             output << Color::BRIGHT_WHITE << " │ " << Color::RESET;
-            output << Color::BRIGHT_YELLOW << "⚡" << formatBytes(static_cast<long long>(currentSpeed)) << "/s" << Color::RESET;
+            output << Color::BRIGHT_YELLOW << "⚡" << run.formatBytes(static_cast<long long>(currentSpeed)) << "/s" << Color::RESET;
             
-            // Status
+            // Status, or achieved vs target when throttled
             output << Color::BRIGHT_WHITE << " │ " << Color::RESET;
-            output << getSpeedIndicator(currentSpeed, stats.avgSpeed);
+            if (run.limiter.enabled()) {
+                output << Color::BRIGHT_GREEN << "🎯" << run.formatBytes(static_cast<long long>(run.achievedRate))
+                       << Color::BRIGHT_BLACK << "/" << Color::WHITE << run.formatBytes(static_cast<long long>(run.limiter.currentRate())) << "/s" << Color::RESET;
+            } else {
+                output << getSpeedIndicator(currentSpeed, run.stats.avgSpeed);
+            }
             
             // Workers
             output << Color::BRIGHT_WHITE << " │ " << Color::RESET;
-            output << Color::BRIGHT_MAGENTA << "🔥" << activeWorkers << "/" << numThreads << Color::RESET;
+            output << Color::BRIGHT_MAGENTA << "🔥" << (run.options.adaptive ? min(run.activeWorkers.load(), run.writerLimit.load()) : run.activeWorkers.load())
+                   << "/" << run.writerCount() << Color::RESET;
+            
+            if (run.batch) {
+                output << Color::BRIGHT_WHITE << " │ " << Color::RESET;
+                output << Color::BRIGHT_GREEN << "📄" << run.filesCreated() << "/" << run.batch->count() << Color::RESET;
+            }
+            
+            // Striped: the member holding the set back
+            double slowestRate = 0;
+            int slowest = run.slowestStripe(elapsed, slowestRate);
+            if (slowest >= 0) {
+                output << Color::BRIGHT_WHITE << " │ " << Color::RESET;
+                output << Color::BRIGHT_RED << "🐢T" << slowest << " " << run.formatBytes(static_cast<long long>(slowestRate)) << "/s" << Color::RESET;
+            }
             
             // ETA
-            if (progress > 0.005 && currentSpeed > 0) {
+            if (!open && progress > 0.005 && currentSpeed > 0) {
                 double eta = (total - current) / currentSpeed;
                 output << Color::BRIGHT_WHITE << " │ " << Color::RESET;
-                output << Color::BRIGHT_BLUE << "⏱" << formatDuration(eta) << Color::RESET;
+                output << Color::BRIGHT_BLUE << "⏱" << run.formatDuration(eta) << Color::RESET;
             }
         }
         
         display.updateProgress(output.str());
     }
 
-    void showBanner() {
-        cout << "\n";
-        cout << Color::BOLD << Color::BRIGHT_CYAN;
-        cout << "  ╔═══════════════════════════════════════════════════════════════════════╗\n";
-        cout << "  ║                                                                       ║\n";
-        cout << "  ║           " << Color::BRIGHT_WHITE << "⚡⚡⚡ TURBO FILE CREATOR " << Color::BRIGHT_YELLOW << "v5.1 " << Color::BRIGHT_WHITE << "⚡⚡⚡" << Color::BRIGHT_CYAN << "              ║\n";
-        cout << "  ║                                                                       ║\n";
-        cout << "  ║     " << Color::BRIGHT_GREEN << "Ultra-Fast" << Color::BRIGHT_BLACK << " • " 
-             << Color::BRIGHT_MAGENTA << "Multi-Threaded" << Color::BRIGHT_BLACK << " • "
-             << Color::BRIGHT_YELLOW << "Optimized I/O" << Color::BRIGHT_BLACK << " • "
-             << Color::BRIGHT_CYAN << "Pro Stats" << Color::BRIGHT_CYAN << "     ║\n";
-        cout << "  ║                                                                       ║\n";
-        cout << "  ╚═══════════════════════════════════════════════════════════════════════╝\n";
-        cout << Color::RESET << "\n";
+    // Workload progress runs against the clock, or the op budget when one was given
+    void workloadProgress(const TurboFileCreator& run, long long reads, long long writes, double elapsed, double limit) override {
+        long long ops = reads + writes;
+        float progress = run.options.opLimit > 0 ? static_cast<float>(ops) / run.options.opLimit : static_cast<float>(elapsed / limit);
+        double iops = elapsed > 0 ? ops / elapsed : 0;
+        
+        stringstream output;
+        output << Color::BRIGHT_WHITE << "  ┃ " << Color::RESET;
+        output << generateProgressBar(min(progress, 1.0f), 45);
+        output << Color::BRIGHT_WHITE << " ┃ " << Color::RESET;
+        output << Color::BRIGHT_CYAN << Color::BOLD << setw(6) << fixed << setprecision(2) << min(progress * 100.0, 100.0) << "%" << Color::RESET;
+        output << Color::BRIGHT_WHITE << " │ " << Color::RESET;
+        output << Color::BRIGHT_YELLOW << "⚡" << fixed << setprecision(0) << iops << " IOPS" << Color::RESET;
+        output << Color::BRIGHT_WHITE << " │ " << Color::RESET;
+        output << Color::BRIGHT_GREEN << "R " << reads << Color::BRIGHT_BLACK << " / " << Color::BRIGHT_MAGENTA << "W " << writes << Color::RESET;
+        output << Color::BRIGHT_WHITE << " │ " << Color::RESET;
+        output << Color::BRIGHT_BLUE << "⏱" << run.formatDuration(elapsed) << Color::RESET;
+        
+        display.updateProgress(output.str());
     }
 
-    void showConfig() {
-        cout << Color::BRIGHT_WHITE << "  ╭─ " << Color::BRIGHT_CYAN << "⚙ CONFIGURATION" << Color::BRIGHT_WHITE << " ──────────────────────────────────────────────╮\n" << Color::RESET;
-        cout << Color::BRIGHT_WHITE << "  │\n";
-        cout << "  │  " << Color::BRIGHT_WHITE << "📁 Target File    : " << Color::BRIGHT_GREEN << fileName << Color::RESET << "\n";
-        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "📏 File Size      : " << Color::BRIGHT_YELLOW << formatBytes(fileSize) << Color::RESET << "\n";
-        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "💾 Buffer Size    : " << Color::BRIGHT_BLUE << bufferSizeMB << " MB per thread" << Color::RESET << "\n";
-        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🔥 Thread Count   : " << Color::BRIGHT_MAGENTA << numThreads << " workers" << Color::RESET << "\n";
-        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🎨 Data Pattern   : " << (useRandomData ? Color::BRIGHT_GREEN + "Random" : Color::BRIGHT_CYAN + "Zero-filled") << Color::RESET << "\n";
-        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "⚡ Turbo Mode     : " << (turboMode ? Color::BRIGHT_GREEN + "ENABLED ✓" : Color::YELLOW + "Standard") << Color::RESET << "\n";
-        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "🚀 Optimization   : " << Color::BRIGHT_CYAN << "Maximum Performance" << Color::RESET << "\n";
-        cout << Color::BRIGHT_WHITE << "  │\n";
-        cout << "  ╰───────────────────────────────────────────────────────────────────╯\n";
-        cout << Color::RESET << "\n";
+    void verifyProgress(const TurboFileCreator& run, long long current, long long total, double elapsed) override {
+        float progress = total > 0 ? static_cast<float>(current) / static_cast<float>(total) : 1.0f;
+        double speed = elapsed > 0 ? current / elapsed : 0;
+        
+        stringstream output;
+        output << Color::BRIGHT_WHITE << "  ┃ " << Color::RESET;
+        output << generateProgressBar(progress, 45);
+        output << Color::BRIGHT_WHITE << " ┃ " << Color::RESET;
+        output << Color::BRIGHT_CYAN << Color::BOLD << setw(6) << fixed << setprecision(2) << (progress * 100.0) << "%" << Color::RESET;
+        output << Color::BRIGHT_WHITE << " │ " << Color::RESET;
+        output << Color::BRIGHT_CYAN << run.formatBytes(current) << Color::RESET;
+        output << Color::BRIGHT_BLACK << "/" << Color::RESET;
+        output << Color::WHITE << run.formatBytes(total) << Color::RESET;
+        output << Color::BRIGHT_WHITE << " │ " << Color::RESET;
+        output << Color::BRIGHT_YELLOW << "🔍" << run.formatBytes(static_cast<long long>(speed)) << "/s" << Color::RESET;
+        
+        display.updateProgress(output.str());
     }
 
-    void showDetailedStats(double totalTime) {
-        stats.efficiency = stats.avgSpeed > 0 ? (stats.avgSpeed / stats.peakSpeed.load()) * 100 : 0;
-        
+    void adapted(const TurboFileCreator& run, const ConcurrencyController::Decision& decision) override {
+        display.clearProgress();
+        cout << Color::BRIGHT_BLACK << "  🎛 " << setw(8) << run.formatDuration(decision.atSeconds) << "  " << Color::BRIGHT_MAGENTA << setw(2) << decision.from
+             << " → " << setw(2) << decision.to << " writers" << Color::BRIGHT_BLACK << " │ " << Color::BRIGHT_YELLOW
+             << run.formatBytes(static_cast<long long>(decision.rate)) << "/s" << Color::BRIGHT_BLACK << " at " << decision.from << " │ " << decision.reason << Color::RESET << "\n";
+    }
+
+    void warning(const TurboFileCreator&, const string& message) override {
+        display.endLine();
+        cout << Color::BRIGHT_YELLOW << "  ⚠ " << message << "\n\n" << Color::RESET;
+    }
+
+    void error(const TurboFileCreator&, const string& message) override {
+        display.endLine();
+        cout << Color::BRIGHT_RED << "\n  ❌ ERROR: " << message << "!\n" << Color::RESET;
+    }
+
+    // A stripe set reads back all of its members at once and reports them in the summary
+    void verifying(const TurboFileCreator& run) override {
+        if (!run.stripes.empty()) {
+            display.clearProgress();
+            cout << Color::BRIGHT_CYAN << "\n  🔍 Verifying " << run.stripeWidth() << " stripe targets...\n" << Color::RESET;
+            return;
+        }
+        cout << Color::BRIGHT_CYAN << "  🔍 Verifying file contents...\n" << Color::RESET;
+        cout << Color::BRIGHT_BLACK << "  ═══════════════════════════════════════════════════════════════════\n" << Color::RESET;
+        cout << "\n";
+    }
+
+    void finished(const TurboFileCreator& run, double totalTime) override {
         display.clearProgress();
         display.newLine();
         
@@ -370,37 +634,91 @@ private:
         cout << Color::BRIGHT_WHITE << "  │\n";
         
         // File info
-        cout << "  │  " << Color::BRIGHT_WHITE << "✓ File Created      : " << Color::BRIGHT_GREEN << fileName << Color::RESET << "\n";
-        cout << "  │  " << Color::BRIGHT_WHITE << "✓ Total Size        : " << Color::BRIGHT_YELLOW << formatBytes(fileSize) << Color::RESET << "\n";
-        cout << "  │  " << Color::BRIGHT_WHITE << "✓ Elapsed Time      : " << Color::BRIGHT_BLUE << formatDuration(totalTime) << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << (run.options.stream ? "✓ Streamed To       : " : "✓ File Created      : ") << Color::BRIGHT_GREEN << run.targetName() << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "✓ Total Size        : " << Color::BRIGHT_YELLOW << run.formatBytes(run.fileSize) << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "✓ Elapsed Time      : " << Color::BRIGHT_BLUE << run.formatDuration(totalTime) << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "✓ Pre-allocation    : " << Color::BRIGHT_CYAN << run.preallocMethod
+             << Color::BRIGHT_BLACK << " (" << run.formatDuration(run.preallocTime) << ")" << Color::RESET << "\n";
+        if (run.options.cloneSeed > 0) {
+            cout << "  │  " << Color::BRIGHT_WHITE << "🧬 Cloned            : " << Color::BRIGHT_CYAN << run.cloneMethodName()
+                 << Color::BRIGHT_BLACK << " (" << run.formatBytes(run.options.cloneSeed) << " seed written, " << run.cloneSummary() << ")" << Color::RESET << "\n";
+        }
+        if (run.useRandomData && run.generator.shaped()) {
+            cout << "  │  " << Color::BRIGHT_WHITE << "🗜 Data Reduction    : " << Color::BRIGHT_CYAN << run.reductionSummary() << Color::RESET << "\n";
+        }
+        if (run.options.resume) {
+            cout << "  │  " << Color::BRIGHT_WHITE << "↻ Resumed           : " << Color::BRIGHT_CYAN << run.formatBytes(run.resumedBytes) << " kept"
+                 << Color::BRIGHT_BLACK << " (" << run.resumeChecked << " units re-read, " << run.resumeRepaired << " rewritten)" << Color::RESET << "\n";
+        }
         
         cout << Color::BRIGHT_WHITE << "  │\n";
         
-        // Speed metrics
-        double finalSpeed = totalTime > 0 ? fileSize / totalTime : 0;
-        cout << "  │  " << Color::BRIGHT_WHITE << "⚡ Final Speed       : " << Color::BRIGHT_CYAN << formatBytes(static_cast<long long>(finalSpeed)) << "/s" << Color::RESET << "\n";
-        cout << "  │  " << Color::BRIGHT_WHITE << "⚡ Average Speed     : " << Color::BRIGHT_YELLOW << formatBytes(static_cast<long long>(stats.avgSpeed)) << "/s" << Color::RESET << "\n";
-        cout << "  │  " << Color::BRIGHT_WHITE << "🚀 Peak Speed        : " << Color::BRIGHT_MAGENTA << formatBytes(static_cast<long long>(stats.peakSpeed.load())) << "/s" << Color::RESET << "\n";
+        // Speed metrics: Final Speed includes the closing flush, so it is what the device sustained
+        double finalSpeed = run.committedSpeed(totalTime);
+        double cachedSpeed = totalTime > 0 ? run.runBytes() / totalTime : 0;
+        cout << "  │  " << Color::BRIGHT_WHITE << "⚡ Final Speed       : " << Color::BRIGHT_CYAN << run.formatBytes(static_cast<long long>(finalSpeed)) << "/s" << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "⚡ Average Speed     : " << Color::BRIGHT_YELLOW << run.formatBytes(static_cast<long long>(run.stats.avgSpeed)) << "/s" << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "🚀 Peak Speed        : " << Color::BRIGHT_MAGENTA << run.formatBytes(static_cast<long long>(run.stats.peakSpeed.load())) << "/s" << Color::RESET << "\n";
+        
+        if (run.limiter.enabled()) {
+            double target = run.limiter.meanRate(totalTime);
+            cout << "  │  " << Color::BRIGHT_WHITE << "🎯 Target Rate       : " << Color::BRIGHT_GREEN << run.formatBytes(static_cast<long long>(target)) << "/s"
+                 << Color::BRIGHT_BLACK << " (achieved " << fixed << setprecision(1) << (target > 0 ? finalSpeed / target * 100 : 0) << "%)" << Color::RESET << "\n";
+        }
+        
+        // Cached Speed only covers the write phase; with buffered I/O that is mostly the page cache
+        cout << "  │  " << Color::BRIGHT_WHITE << "🧊 Cached Speed      : " << Color::BRIGHT_BLUE;
+        if (run.options.directIO) cout << "n/a (direct I/O)";
+        else cout << run.formatBytes(static_cast<long long>(cachedSpeed)) << "/s";
+        cout << Color::RESET << "\n";
+        #ifndef _WIN32
+        cout << "  │  " << Color::BRIGHT_WHITE << "🔒 Durability        : " << Color::BRIGHT_GREEN << run.syncName(run.options.sync);
+        if (run.options.stream) {
+            cout << Color::BRIGHT_BLACK << " (stream, handed to the reader)";
+        } else if (run.options.sync == SyncMode::None) {
+            cout << Color::BRIGHT_BLACK << " (data may still be in the page cache)";
+        } else {
+            cout << Color::BRIGHT_BLACK << " (" << run.formatDuration(run.inRunSyncNanos() / 1e9) << " in-run syncs, "
+                 << run.formatDuration(run.flushTime) << " final flush)";
+        }
+        cout << Color::RESET << "\n";
+        #endif
         
         cout << Color::BRIGHT_WHITE << "  │\n";
         
         // Thread info
-        cout << "  │  " << Color::BRIGHT_WHITE << "🔥 Threads Used      : " << Color::BRIGHT_MAGENTA << numThreads << " workers" << Color::RESET << "\n";
-        cout << "  │  " << Color::BRIGHT_WHITE << "💾 Buffer per Thread : " << Color::BRIGHT_BLUE << bufferSizeMB << " MB" << Color::RESET << "\n";
-        cout << "  │  " << Color::BRIGHT_WHITE << "📊 Total Operations  : " << Color::BRIGHT_CYAN << stats.operationCount.load() << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "🔥 Threads Used      : " << Color::BRIGHT_MAGENTA << run.writerCount() << " workers" << Color::RESET << "\n";
+        if (run.options.adaptive) {
+            cout << "  │  " << Color::BRIGHT_WHITE << "🎛 Adaptive          : " << Color::BRIGHT_MAGENTA << run.controller.writers() << " active"
+                 << Color::BRIGHT_BLACK << (run.controller.settled() ? " (settled: " : " (still searching: ") << adaptiveTrail(run) << ")" << Color::RESET << "\n";
+        }
+        cout << "  │  " << Color::BRIGHT_WHITE << "🛠 Write Engine      : " << Color::BRIGHT_CYAN << run.backendName() << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "💾 Buffer per Thread : " << Color::BRIGHT_BLUE << run.bufferSizeMB << " MB"
+             << Color::BRIGHT_BLACK << (run.zeroBuffer ? " (one shared zero buffer)" : "") << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "🧠 Buffer Memory     : " << Color::BRIGHT_BLUE << run.formatBytes(AlignedBuffer::usage().peak.load()) << " peak"
+             << Color::BRIGHT_BLACK << " (" << run.bufferPageKind() << ")" << Color::RESET << "\n";
+        if (run.peakResidentBytes() > 0) {
+            cout << "  │  " << Color::BRIGHT_WHITE << "🧠 Peak RSS          : " << Color::BRIGHT_BLUE << run.formatBytes(run.peakResidentBytes()) << Color::RESET << "\n";
+        }
+        cout << "  │  " << Color::BRIGHT_WHITE << "📊 Total Operations  : " << Color::BRIGHT_CYAN << run.stats.operationCount.load() << Color::RESET << "\n";
         
         cout << Color::BRIGHT_WHITE << "  │\n";
+        if (run.batch) showBatchStats(run, totalTime);
+        if (!run.stripes.empty()) showStripeStats(run);
+        showStageUtilization(run, totalTime);
+        showLatencyStats(run);
+        showWorkerBalance(run);
         
         // Efficiency
         cout << "  │  " << Color::BRIGHT_WHITE << "📈 Thread Efficiency : ";
-        if (stats.efficiency > 85) cout << Color::BRIGHT_GREEN;
-        else if (stats.efficiency > 70) cout << Color::BRIGHT_YELLOW;
+        if (run.stats.efficiency > 85) cout << Color::BRIGHT_GREEN;
+        else if (run.stats.efficiency > 70) cout << Color::BRIGHT_YELLOW;
         else cout << Color::BRIGHT_RED;
-        cout << fixed << setprecision(1) << stats.efficiency << "%" << Color::RESET;
+        cout << fixed << setprecision(1) << run.stats.efficiency << "%" << Color::RESET;
         
-        if (stats.efficiency > 90) cout << Color::BRIGHT_GREEN << " ★ EXCELLENT" << Color::RESET;
-        else if (stats.efficiency > 80) cout << Color::GREEN << " ✓ GREAT" << Color::RESET;
-        else if (stats.efficiency > 70) cout << Color::YELLOW << " ➜ GOOD" << Color::RESET;
+        if (run.stats.efficiency > 90) cout << Color::BRIGHT_GREEN << " ★ EXCELLENT" << Color::RESET;
+        else if (run.stats.efficiency > 80) cout << Color::GREEN << " ✓ GREAT" << Color::RESET;
+        else if (run.stats.efficiency > 70) cout << Color::YELLOW << " ➜ GOOD" << Color::RESET;
         cout << "\n";
         
         // Speed rating
@@ -414,10 +732,11 @@ private:
         cout << " (" << fixed << setprecision(0) << speedMBps << " MB/s)\n";
         
         // Sparkline
-        if (!stats.speedSamples.empty()) {
+        vector<double> samples = run.stats.recentSamples();
+        if (!samples.empty()) {
             cout << Color::BRIGHT_WHITE << "  │\n";
             cout << "  │  " << Color::BRIGHT_WHITE << "📈 Speed History     : ";
-            cout << generateSparkline(stats.speedSamples, 35) << "\n";
+            cout << generateSparkline(samples, 35) << "\n";
         }
         
         cout << Color::BRIGHT_WHITE << "  │\n";
@@ -425,145 +744,56 @@ private:
         cout << Color::RESET << "\n";
     }
 
-    void turboWriter(int threadID, long long startPos, long long endPos) {
-        try {
-            activeWorkers++;
-            
-            size_t bufSize = static_cast<size_t>(bufferSizeMB) * 1024 * 1024;
-            vector<char> buffer(bufSize);
-            
-            if (useRandomData) {
-                unsigned int seed = threadID * 123456789;
-                for (size_t i = 0; i < bufSize; i += 8) {
-                    seed = seed * 1103515245 + 12345;
-                    *reinterpret_cast<unsigned int*>(&buffer[i]) = seed;
-                }
-            }
-            
-            ofstream file(fileName, ios::binary | ios::in | ios::out);
-            if (!file) {
-                errorFlag = true;
-                activeWorkers--;
-                return;
-            }
-            
-            file.rdbuf()->pubsetbuf(nullptr, 0);
-            file.seekp(startPos);
-            long long pos = startPos;
-            
-            while (pos < endPos && !errorFlag) {
-                long long remaining = endPos - pos;
-                long long writeSize = min(static_cast<long long>(bufSize), remaining);
-                
-                file.write(buffer.data(), writeSize);
-                
-                if (!file.good()) {
-                    errorFlag = true;
-                    activeWorkers--;
-                    return;
-                }
-                
-                pos += writeSize;
-                bytesWritten += writeSize;
-                stats.operationCount++;
-            }
-            
-            file.close();
-            activeWorkers--;
-            
-        } catch (...) {
-            errorFlag = true;
-            activeWorkers--;
-        }
-    }
-
-public:
-    TurboFileCreator(const string& filename, long long size, int threads = 4, 
-                     int bufferMB = 32, bool randomData = false, bool turbo = true) 
-        : fileName(filename), fileSize(size), numThreads(threads), 
-          bufferSizeMB(bufferMB), useRandomData(randomData), turboMode(turbo) {
-        setupConsole();
+    void workloadFinished(const TurboFileCreator& run, double totalTime) override {
+        LatencyHistogram reads, writes;
+        long long readBytes, writeBytes;
+        run.workloadTotals(reads, writes, readBytes, writeBytes);
+        long long ops = static_cast<long long>(reads.count() + writes.count());
         
-        if (numThreads <= 0) {
-            numThreads = max(1u, thread::hardware_concurrency());
-        }
-        
-        if (turboMode) {
-            bufferSizeMB = max(bufferSizeMB, 32);
-            numThreads = max(numThreads, 4);
-        }
+        display.clearProgress();
+        cout << Color::BRIGHT_CYAN << "  ╭─ " << Color::BRIGHT_WHITE << "📊 WORKLOAD RESULTS" << Color::BRIGHT_CYAN << " ───────────────────────────────────────────╮\n" << Color::RESET;
+        cout << Color::BRIGHT_WHITE << "  │\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "✓ Operations        : " << Color::BRIGHT_YELLOW << ops << Color::BRIGHT_BLACK << " in " << run.formatDuration(totalTime) << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "⚡ Total IOPS        : " << Color::BRIGHT_CYAN << fixed << setprecision(0) << (totalTime > 0 ? ops / totalTime : 0)
+             << Color::BRIGHT_BLACK << " (" << run.formatBytes(static_cast<long long>(totalTime > 0 ? (readBytes + writeBytes) / totalTime : 0)) << "/s)" << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │\n";
+        showOpStats(run, "📖 Reads            : ", reads, readBytes, totalTime);
+        showOpStats(run, "✏ Writes           : ", writes, writeBytes, totalTime);
+        cout << Color::BRIGHT_WHITE << "  │\n";
+        cout << "  ╰───────────────────────────────────────────────────────────────────╯\n";
+        cout << Color::RESET << "\n";
     }
 
-    bool execute() {
-        showBanner();
-        showConfig();
-        
-        cout << Color::BRIGHT_CYAN << "  ⚡ Initializing turbo file creation...\n" << Color::RESET;
-        cout << Color::BRIGHT_BLACK << "  ═══════════════════════════════════════════════════════════════════\n" << Color::RESET;
-        cout << "\n";
-
-        // Pre-allocate file
-        {
-            ofstream file(fileName, ios::binary);
-            if (!file) {
-                cout << Color::BRIGHT_RED << "  ❌ ERROR: Cannot create file!\n" << Color::RESET;
-                return false;
-            }
-            
-            file.seekp(fileSize - 1);
-            file.write("", 1);
-            file.close();
-        }
-
-        // Initialize display
-        display.initialize();
-
-        auto startTime = steady_clock::now();
-
-        // Launch workers
-        vector<thread> workers;
-        long long chunkSize = fileSize / numThreads;
+    void verified(const TurboFileCreator& run, bool passed, long long actualSize, double totalTime) override {
+        double readSpeed = totalTime > 0 ? run.bytesVerified.load() / totalTime : 0;
+        verifyProgress(run, run.bytesVerified.load(), min(actualSize, run.fileSize), totalTime);
+        display.clearProgress();
+        display.cleanup();
         
-        for (int i = 0; i < numThreads; i++) {
-            long long start = i * chunkSize;
-            long long end = (i == numThreads - 1) ? fileSize : (i + 1) * chunkSize;
-            workers.emplace_back(&TurboFileCreator::turboWriter, this, i, start, end);
-        }
-
-        // Monitor progress
-        while (bytesWritten < fileSize && !errorFlag) {
-            this_thread::sleep_for(milliseconds(50));
-            
-            auto now = steady_clock::now();
-            double elapsed = duration<double>(now - startTime).count();
-            
-            displayProgress(bytesWritten.load(), fileSize, elapsed);
+        cout << Color::BRIGHT_CYAN << "  ╭─ " << Color::BRIGHT_WHITE << "🔍 VERIFICATION" << Color::BRIGHT_CYAN << " ───────────────────────────────────────────────╮\n" << Color::RESET;
+        cout << Color::BRIGHT_WHITE << "  │\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "🔍 Result            : " << (passed ? Color::BRIGHT_GREEN + "PASSED ✓" : Color::BRIGHT_RED + "FAILED ✗") << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "✓ Bytes Verified    : " << Color::BRIGHT_YELLOW << run.formatBytes(run.bytesVerified.load()) << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "⚡ Read Speed        : " << Color::BRIGHT_CYAN << run.formatBytes(static_cast<long long>(readSpeed)) << "/s" << Color::RESET << "\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "🧮 Comparison        : " << Color::BRIGHT_BLUE << "byte-exact per " << run.bufferSizeMB << " MB block" << Color::RESET << "\n";
+        if (actualSize != run.fileSize) {
+            cout << "  │  " << Color::BRIGHT_WHITE << "✗ Size Mismatch     : " << Color::BRIGHT_RED << run.formatBytes(actualSize) << " on disk, expected " << run.formatBytes(run.fileSize) << Color::RESET << "\n";
         }
-
-        // Wait for workers
-        for (auto& worker : workers) {
-            if (worker.joinable()) worker.join();
+        if (run.firstMismatch.load() != LLONG_MAX) {
+            cout << "  │  " << Color::BRIGHT_WHITE << "✗ First Mismatch    : " << Color::BRIGHT_RED << "offset " << run.firstMismatch.load()
+                 << " (0x" << hex << run.firstMismatch.load() << dec << ")" << Color::RESET << "\n";
         }
-
-        auto endTime = steady_clock::now();
-        double totalTime = duration<double>(endTime - startTime).count();
-
-        // Cleanup display
-        display.cleanup();
-
-        if (errorFlag) {
-            cout << Color::BRIGHT_RED << "\n\n  ❌ ERROR: Write operation failed!\n" << Color::RESET;
-            return false;
+        if (run.errorFlag) {
+            cout << "  │  " << Color::BRIGHT_WHITE << "✗ Read Error        : " << Color::BRIGHT_RED << "I/O error while reading back" << Color::RESET << "\n";
         }
-
-        // Final progress
-        displayProgress(fileSize, fileSize, totalTime);
-        
-        showDetailedStats(totalTime);
-        return true;
+        cout << Color::BRIGHT_WHITE << "  │\n";
+        cout << "  ╰───────────────────────────────────────────────────────────────────╯\n";
+        cout << Color::RESET << "\n";
     }
 };
 
+} // namespace turbo
+
 long long parseSizeInput(const string& input) {
     stringstream ss(input);
     double value;
@@ -585,10 +815,469 @@ long long parseSizeInput(const string& input) {
     return static_cast<long long>(value * 1024 * 1024);
 }
 
+const char* engineKey(WriteBackend backend) {
+    switch (backend) {
+        case WriteBackend::IoUring: return "uring";
+        case WriteBackend::Mmap: return "mmap";
+        default: return "stream";
+    }
+}
+
+// Tuned Configuration
+// Result of a bench sweep, saved as "key=value" lines so later runs can start from it
+struct TuningProfile {
+    WriteBackend backend = WriteBackend::Stream;
+    int threads = 4;
+    int bufferMB = 32;
+    int queueDepth = 32;
+    double throughput = 0;
+
+    bool save(const string& path, const string& target) const {
+        ofstream file(path);
+        if (!file) return false;
+        
+        file << "# file_creator bench result for " << target << "\n";
+        file << "engine=" << engineKey(backend) << "\n";
+        file << "threads=" << threads << "\n";
+        file << "buffer_mb=" << bufferMB << "\n";
+        file << "qd=" << queueDepth << "\n";
+        file << "throughput_bps=" << static_cast<long long>(throughput) << "\n";
+        return file.good();
+    }
+
+    bool load(const string& path) {
+        ifstream file(path);
+        if (!file) return false;
+        
+        string line;
+        bool any = false;
+        while (getline(file, line)) {
+            size_t eq = line.find('=');
+            if (line.empty() || line[0] == '#' || eq == string::npos) continue;
+            
+            string key = line.substr(0, eq);
+            string value = line.substr(eq + 1);
+            if (key == "engine") backend = value == "uring" ? WriteBackend::IoUring : value == "mmap" ? WriteBackend::Mmap : WriteBackend::Stream;
+            else if (key == "threads") threads = max(1, atoi(value.c_str()));
+            else if (key == "buffer_mb") bufferMB = max(1, atoi(value.c_str()));
+            else if (key == "qd") queueDepth = max(1, atoi(value.c_str()));
+            else if (key == "throughput_bps") throughput = atof(value.c_str());
+            else continue;
+            any = true;
+        }
+        return any;
+    }
+};
+
+// Accepts "200MB/s", "200 MB/s" or a plain size; anything else is -1
+double parseRateInput(string input) {
+    input.erase(input.find_last_not_of(" \t\r") + 1);
+    if (input.size() > 2) {
+        string suffix = input.substr(input.size() - 2);
+        if (suffix == "/s" || suffix == "/S") input.erase(input.size() - 2);
+    }
+    
+    stringstream ss(input);
+    double value;
+    string unit, extra;
+    if (!(ss >> value)) return -1;
+    ss >> unit;
+    if (ss >> extra) return -1;
+    transform(unit.begin(), unit.end(), unit.begin(), ::toupper);
+    const char* units[] = {"", "B", "BYTE", "BYTES", "KB", "MB", "GB", "TB", "PB"};
+    if (find(begin(units), end(units), unit) == end(units)) return -1;
+    return static_cast<double>(parseSizeInput(input));
+}
+
+// Step schedule: one "<seconds> <rate>" pair per line, '#' starts a comment
+bool loadRateProfile(const string& path, vector<RateStep>& steps) {
+    ifstream file(path);
+    if (!file) return false;
+    
+    string line;
+    while (getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        stringstream ss(line);
+        double at;
+        if (!(ss >> at)) continue;
+        
+        string rate;
+        getline(ss >> ws, rate);
+        if (rate.empty()) return false;
+        double bytesPerSec = parseRateInput(rate);
+        if (bytesPerSec < 0) return false;
+        steps.push_back({at, bytesPerSec});
+    }
+    return !steps.empty();
+}
+
+// Manifest: one "<path> <size>" per line, paths relative to the batch root unless absolute
+bool loadManifest(const string& path, BatchPlan& plan) {
+    ifstream file(path);
+    if (!file) return false;
+    
+    string line;
+    while (getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        stringstream ss(line);
+        string target, size;
+        if (!(ss >> target)) continue;
+        
+        getline(ss >> ws, size);
+        long long bytes = size.empty() ? 0 : parseSizeInput(size);
+        if (bytes < 0) return false;
+        plan.manifest.push_back(make_pair(target, bytes));
+    }
+    return !plan.manifest.empty();
+}
+
+// "4KB" fixed, "4KB-1MB" log-uniform range, or "4KB:70,64KB:25,1MB:5" weighted mix
+bool parseSizeMix(const string& spec, BatchPlan& plan) {
+    plan.sizeMix.clear();
+    if (spec.find(',') == string::npos && spec.find(':') == string::npos) {
+        size_t dash = spec.find('-');
+        plan.rangeMin = parseSizeInput(spec.substr(0, dash));
+        plan.rangeMax = dash == string::npos ? plan.rangeMin : parseSizeInput(spec.substr(dash + 1));
+        return plan.rangeMin >= 0 && plan.rangeMax >= plan.rangeMin;
+    }
+    
+    stringstream ss(spec);
+    string item;
+    double cumulative = 0;
+    while (getline(ss, item, ',')) {
+        size_t colon = item.find(':');
+        double weight = colon == string::npos ? 1.0 : atof(item.c_str() + colon + 1);
+        long long bytes = parseSizeInput(item.substr(0, colon));
+        if (bytes < 0 || weight <= 0) return false;
+        cumulative += weight;
+        plan.sizeMix.push_back({bytes, cumulative});
+    }
+    return !plan.sizeMix.empty();
+}
+
+vector<int> parseIntList(const string& input) {
+    vector<int> values;
+    stringstream ss(input);
+    string item;
+    while (getline(ss, item, ',')) {
+        int value = atoi(item.c_str());
+        if (value > 0) values.push_back(value);
+    }
+    return values;
+}
+
+bool isFifo(const string& path) {
+    #ifdef _WIN32
+    (void)path;
+    return false;
+    #else
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && S_ISFIFO(info.st_mode);
+    #endif
+}
+
+// Creates the file only if nothing is at the path yet, so a scratch file never lands on existing data
+bool createExclusive(const string& path) {
+    #ifdef _WIN32
+    int fd = _open(path.c_str(), _O_CREAT | _O_EXCL | _O_WRONLY | _O_BINARY, _S_IREAD | _S_IWRITE);
+    if (fd < 0) return false;
+    _close(fd);
+    #else
+    int fd = open(path.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0644);
+    if (fd < 0) return false;
+    close(fd);
+    #endif
+    return true;
+}
+
+bool isDirectory(const string& path) {
+    #ifdef _WIN32
+    DWORD attributes = GetFileAttributesA(path.c_str());
+    return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY);
+    #else
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode);
+    #endif
+}
+
+// Bench Sweep
+// Writes a sample with every engine/thread/buffer combination and ranks them by median device throughput
+int runBench(const string& target, long long sampleSize, vector<int> threadCounts, vector<int> bufferSizes,
+             int repeats, const CreatorOptions& baseOptions, bool randomData, const string& savePath) {
+    bool headless = baseOptions.format != OutputFormat::Text;
+    
+    // The sample never replaces anything: a directory gets a new hidden file, any other target must not exist
+    bool inDirectory = isDirectory(target);
+    string sampleFile = target;
+    bool held = false;
+    for (int n = 0; n < (inDirectory ? 100 : 1) && !held; n++) {
+        if (inDirectory) sampleFile = target + "/.file_creator_bench" + (n > 0 ? "." + to_string(n) : "") + ".tmp";
+        held = createExclusive(sampleFile);
+    }
+    
+    if (threadCounts.empty()) {
+        int limit = max(4, min(64, static_cast<int>(thread::hardware_concurrency())));
+        for (int t = 1; t <= limit; t *= 2) threadCounts.push_back(t);
+    }
+    if (bufferSizes.empty()) bufferSizes = {4, 16, 64};
+    repeats = max(1, repeats);
+    
+    vector<WriteBackend> backends = {WriteBackend::Stream};
+    #ifdef TURBO_HAVE_IO_URING
+    if (UringQueue::isSupported()) backends.push_back(WriteBackend::IoUring);
+    #endif
+    #ifndef _WIN32
+    backends.push_back(WriteBackend::Mmap);
+    #endif
+    
+    auto emit = [&](const StructuredRecord& record) {
+        if (baseOptions.format == OutputFormat::Json) {
+            cout << record.json() << "\n" << flush;
+        } else {
+            static vector<string> shown;
+            if (find(shown.begin(), shown.end(), record.type()) == shown.end()) {
+                cout << record.csvHeader() << "\n";
+                shown.push_back(record.type());
+            }
+            cout << record.csvRow() << "\n" << flush;
+        }
+    };
+    
+    if (!held) {
+        string message = "Bench target '" + target + "' already exists; give a directory or a new file name";
+        if (headless) emit(StructuredRecord("error").addText("message", message));
+        else cout << Color::BRIGHT_RED << "\n  ❌ ERROR: " << message << "!\n" << Color::RESET;
+        return 1;
+    }
+    
+    if (!headless) {
+        Dashboard::showBanner();
+        cout << Color::BRIGHT_WHITE << "  ╭─ " << Color::BRIGHT_CYAN << "🧪 BENCHMARK" << Color::BRIGHT_WHITE << " ──────────────────────────────────────────────────╮\n" << Color::RESET;
+        cout << Color::BRIGHT_WHITE << "  │\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "📁 Target : " << Color::BRIGHT_GREEN << sampleFile << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │  " << Color::BRIGHT_WHITE << "📏 Sample : " << Color::BRIGHT_YELLOW << sampleSize / (1024 * 1024) << " MB x " << repeats << " runs per configuration" << Color::RESET << "\n";
+        cout << Color::BRIGHT_WHITE << "  │\n";
+        cout << "  │  " << Color::BRIGHT_BLACK << left << setw(11) << "Engine" << right << setw(8) << "Workers" << setw(10) << "Buffer"
+             << setw(14) << "Median" << setw(20) << "Min - Max" << Color::RESET << "\n";
+    }
+    
+    TuningProfile best;
+    for (WriteBackend backend : backends) {
+        for (int threads : threadCounts) {
+            for (int bufferMB : bufferSizes) {
+                CreatorOptions options = baseOptions;
+                options.quiet = true;
+                options.verifyAfterWrite = false;
+                options.metricsFile.clear();
+                options.metricsListen.clear();
+                options.backend = backend;
+                if (backend == WriteBackend::IoUring) options.submitters = threads;
+                
+                vector<double> runs;
+                for (int r = 0; r < repeats; r++) {
+                    // Every run after the first claims the path again, in case something took it meanwhile
+                    if (!held && !createExclusive(sampleFile)) break;
+                    held = false;
+                    TurboFileCreator creator(sampleFile, sampleSize, threads, bufferMB, randomData, false, options);
+                    bool ok = creator.execute();
+                    remove(sampleFile.c_str());
+                    if (!ok) break;
+                    runs.push_back(creator.deviceThroughput());
+                }
+                if (runs.size() < static_cast<size_t>(repeats)) {
+                    if (headless) emit(StructuredRecord("error").addText("message", "Bench run failed"));
+                    else cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Cannot write bench sample '" << sampleFile << "'!\n" << Color::RESET;
+                    return 1;
+                }
+                
+                sort(runs.begin(), runs.end());
+                double median = (runs[(runs.size() - 1) / 2] + runs[runs.size() / 2]) / 2;
+                bool improved = median > best.throughput;
+                if (improved) {
+                    best.backend = backend;
+                    best.threads = threads;
+                    best.bufferMB = bufferMB;
+                    best.queueDepth = options.queueDepth;
+                    best.throughput = median;
+                }
+                
+                string engine = backend == WriteBackend::IoUring ? "io_uring" : backend == WriteBackend::Mmap ? "mmap" : "ofstream";
+                if (headless) {
+                    StructuredRecord record("bench");
+                    record.addText("engine", engine)
+                          .addInt("workers", threads)
+                          .addInt("buffer_mb", bufferMB)
+                          .addInt("runs", repeats)
+                          .addNumber("median_bps", median, 0)
+                          .addNumber("min_bps", runs.front(), 0)
+                          .addNumber("max_bps", runs.back(), 0);
+                    emit(record);
+                } else {
+                    const double MB = 1024.0 * 1024.0;
+                    cout << "  │  " << Color::BRIGHT_CYAN << left << setw(11) << engine << right
+                         << Color::BRIGHT_MAGENTA << setw(8) << threads
+                         << Color::BRIGHT_BLUE << setw(7) << bufferMB << " MB"
+                         << (improved ? Color::BRIGHT_GREEN : Color::WHITE) << setw(9) << fixed << setprecision(0) << median / MB << " MB/s"
+                         << Color::BRIGHT_BLACK << setw(10) << runs.front() / MB << " - " << setw(5) << runs.back() / MB << Color::RESET << "\n";
+                }
+            }
+        }
+    }
+    
+    bool saved = !savePath.empty() && best.save(savePath, target);
+    
+    if (headless) {
+        StructuredRecord record("tuning");
+        record.addText("engine", engineKey(best.backend))
+              .addInt("workers", best.threads)
+              .addInt("buffer_mb", best.bufferMB)
+              .addInt("qd", best.queueDepth)
+              .addNumber("throughput_bps", best.throughput, 0)
+              .addText("saved_to", saved ? savePath : "");
+        emit(record);
+    } else {
+        cout << Color::BRIGHT_WHITE << "  │\n";
+        cout << "  │  " << Color::BRIGHT_WHITE << "🏆 Recommended : " << Color::BRIGHT_GREEN
+             << (best.backend != WriteBackend::Stream ? string("--engine=") + engineKey(best.backend) + " " : "") << best.threads << " " << (best.backend == WriteBackend::IoUring ? "submitters" : "threads")
+             << ", " << best.bufferMB << " MB buffers" << Color::BRIGHT_BLACK << " (" << fixed << setprecision(0)
+             << best.throughput / (1024.0 * 1024.0) << " MB/s)" << Color::RESET << "\n";
+        if (saved) {
+            cout << "  │  " << Color::BRIGHT_WHITE << "💾 Saved to    : " << Color::BRIGHT_CYAN << savePath
+                 << Color::BRIGHT_BLACK << " (reuse with --tuning=" << savePath << ")" << Color::RESET << "\n";
+        }
+        cout << Color::BRIGHT_WHITE << "  │\n";
+        cout << "  ╰───────────────────────────────────────────────────────────────────╯\n";
+        cout << Color::RESET << "\n";
+    }
+    
+    if (!savePath.empty() && !saved) {
+        if (!headless) cout << Color::BRIGHT_RED << "  ❌ ERROR: Cannot write tuning file '" << savePath << "'!\n\n" << Color::RESET;
+        return 1;
+    }
+    return 0;
+}
+
+// The command line is a front end over the job API: every command is one foreground job
+JobSpec cliJob(JobKind kind, const string& path, long long size, int threads, int bufferMB, bool randomData, bool turbo,
+               const CreatorOptions& options) {
+    JobSpec spec;
+    spec.kind = kind;
+    spec.path = path;
+    spec.size = size;
+    spec.threads = threads;
+    spec.bufferMB = bufferMB;
+    spec.randomData = randomData;
+    spec.turbo = turbo;
+    spec.options = options;
+    return spec;
+}
+
+// Set from the SIGINT handler; runJob turns it into an orderly cancel
+static volatile sig_atomic_t interruptRequested = 0;
+
+void onInterrupt(int) {
+    interruptRequested = 1;
+}
+
+bool runJob(const JobSpec& spec) {
+    // Other runs keep the default Ctrl-C, which simply ends the process
+    bool orderlyStop = !spec.options.checkpointPath.empty() || spec.options.unbounded;
+    void (*previous)(int) = SIG_DFL;
+    if (orderlyStop) {
+        interruptRequested = 0;
+        previous = signal(SIGINT, onInterrupt);
+    }
+    
+    unique_ptr<Job> job = Job::submit(spec);
+    shared_future<JobResult> result = job->result();
+    while (result.wait_for(milliseconds(50)) != future_status::ready) {
+        if (interruptRequested) job->cancel();
+    }
+    
+    if (orderlyStop) signal(SIGINT, previous);
+    return result.get().succeeded;
+}
+
+void printUsage(const char* program) {
+    cout << "\n";
+    cout << Color::BRIGHT_WHITE << "  Usage: " << Color::BRIGHT_CYAN << program << " <filename> <size> [unit] [threads] [buffer_mb] [options]\n\n" << Color::RESET;
+    cout << Color::BRIGHT_YELLOW << "  Options:\n" << Color::RESET;
+    cout << Color::WHITE;
+    cout << "    --random              Fill the file with pseudo-random data (unique per 4 KB block)\n";
+    cout << "    --compress=RATIO      Random data that compresses about RATIO:1 (e.g. 2.5)\n";
+    cout << "    --dedup=RATIO         Random data where only 1/RATIO of the chunks are distinct\n";
+    cout << "    --dedup-block=SIZE    Dedup chunk size, e.g. the ZFS recordsize (default: 4KB)\n";
+    cout << "    --seed=N              Random data seed, decimal or 0x-hex (default: 0x5EEDF11EC0DE)\n";
+    cout << "    --engine=stream|uring|mmap  Write backend (default: stream)\n";
+    cout << "    --qd=N                io_uring writes in flight per submitter (default: 32)\n";
+    cout << "    --submitters=N        io_uring submitter threads (default: 1)\n";
+    cout << "    --msync=none|async|sync      mmap engine: flush each unit (default: none)\n";
+    cout << "    --madvise=normal|sequential|hugepage  mmap engine: mapping hint (default: sequential)\n";
+    cout << "    --sync=MODE           none|end|periodic|rolling durability (default: end)\n";
+    cout << "    --sync-every=MB       Interval for --sync=periodic (default: 256)\n";
+    cout << "    --pipeline=N          Random data: buffers per writer for overlapped generate/write (default: 2, 0 = off)\n";
+    cout << "    --chunk=MB            Work unit handed to writers on demand (default: auto)\n";
+    cout << "    --adaptive[=MAX]      Tune the active writer count at runtime, up to MAX (default: the thread count, or 32)\n";
+    cout << "    --cpus=LIST           Pin writers round-robin to these CPUs, e.g. 0-7,16-23\n";
+    cout << "    --numa-local          Allocate each writer's buffers on its own NUMA node\n";
+    cout << "    --ioprio=CLASS[:N]    Writer I/O priority: rt|be|idle, level 0-7 (default: inherited)\n";
+    cout << "    --nice=N              Adjust writer CPU niceness by N (positive yields to other work)\n";
+    cout << "    --direct              Bypass the page cache with O_DIRECT and aligned buffers\n";
+    cout << "    --prealloc=MODE       fallocate|posix|zero-range|none (default: fallocate)\n";
+    cout << "    --alloc-only          Only allocate the file (no data writes, reads as zeroes)\n";
+    cout << "    --verify              Read the file back after writing and compare it with the pattern\n";
+    cout << "    --verify-only         Only verify an existing file against the pattern (no write)\n";
+    cout << "    --clone[=SIZE]        Write a SIZE seed (default: 64MB), then replicate it by reflink or copy_file_range\n";
+    cout << "    --targets=LIST        Stripe the file RAID-0 style over <filename> and these paths, e.g. /mnt/b/f,/mnt/c/f\n";
+    cout << "    --stripe-unit=SIZE    Bytes per target before moving to the next (default: 1MB)\n";
+    cout << "    --stream-copy         Stream targets: use write() instead of zero-copy vmsplice\n";
+    cout << "    --checkpoint[=FILE]   Record finished units so an interrupted run can resume (default: <file>.ckpt)\n";
+    cout << "    --resume              Continue an interrupted run, skipping units its checkpoint marks done\n";
+    cout << "    --resume-verify=N     Re-read N finished units before resuming and rewrite any that differ\n";
+    cout << "    --read-pct=N          Workload: percentage of operations that are reads (default: 50)\n";
+    cout << "    --bs=SIZE             Workload: bytes per operation, independent of buffer_mb (default: 4KB)\n";
+    cout << "    --dist=seq|random|zipf[:THETA]  Workload: offset distribution (default: random, zipf theta 1.2)\n";
+    cout << "    --duration=S          Workload: run for S seconds (default: 10 unless --ops is given)\n";
+    cout << "    --ops=N               Workload: stop after N operations\n";
+    cout << "    --format=text|json|csv  Output format (default: text, json when stdout is not a terminal)\n";
+    cout << "    --progress-interval=S   Emit a progress record every S seconds in json/csv mode\n";
+    cout << "    --metrics-file=PATH   Rewrite Prometheus metrics to PATH during the run\n";
+    cout << "    --metrics-listen=ADDR Serve the same metrics over HTTP on [HOST:]PORT or unix:PATH\n";
+    cout << "    --metrics-interval=S  Seconds between metrics updates (default: 5)\n";
+    cout << "    --rate=RATE           Throttle all writers to a shared target, e.g. 200MB/s\n";
+    cout << "    --burst=SIZE          Token bucket depth for --rate (default: 100 ms of the target)\n";
+    cout << "    --rate-ramp=S         Ramp linearly from 0 to the target over S seconds\n";
+    cout << "    --rate-profile=FILE   Step schedule of \"<seconds> <rate>\" lines\n";
+    cout << "    --tuning=FILE         Start from a configuration saved by 'bench'\n";
+    cout << "    --help                Show this help message\n\n";
+    cout << Color::RESET;
+    cout << Color::BRIGHT_YELLOW << "  Commands:\n" << Color::RESET;
+    cout << Color::WHITE;
+    cout << "    " << program << " - <size|unbounded> [threads] [buffer_mb] [options] | consumer\n";
+    cout << "    " << program << " <fifo> <size|unbounded> [threads] [buffer_mb] [options]\n";
+    cout << "    " << program << " <filename> --verify-only [threads] [buffer_mb] [--random] [--seed=N] [--direct]\n";
+    cout << "    " << program << " workload <filename> [threads] [buffer_mb] [--read-pct=70] [--bs=4KB] [--dist=zipf]\n";
+    cout << "          [--duration=S|--ops=N] [--random] [--direct]\n";
+    cout << "    " << program << " bench <path> [sample_size] [unit] [--bench-threads=1,2,4] [--bench-buffers=4,16,64]\n";
+    cout << "          [--repeat=N] [--save-tuning=FILE]\n";
+    cout << "    " << program << " batch <root_dir> [threads] [buffer_mb] --manifest=FILE\n";
+    cout << "    " << program << " batch <root_dir> [threads] [buffer_mb] --count=N [--sizes=4KB-1MB] [--fanout=16x2]\n\n";
+    cout << Color::RESET;
+}
+
 int main(int argc, char* argv[]) {
     #ifdef _WIN32
     SetConsoleOutputCP(CP_UTF8);
     SetConsoleCP(CP_UTF8);
+    
+    HANDLE hOut = GetStdHandle(STD_OUTPUT_HANDLE);
+    if (hOut != INVALID_HANDLE_VALUE) {
+        DWORD dwMode = 0;
+        if (GetConsoleMode(hOut, &dwMode)) {
+            dwMode |= ENABLE_VIRTUAL_TERMINAL_PROCESSING;
+            SetConsoleMode(hOut, dwMode);
+        }
+    }
     #endif
     
     string fileName;
@@ -597,26 +1286,375 @@ int main(int argc, char* argv[]) {
     int bufferMB = 32;
     bool randomData = false;
     bool turbo = true;
+    CreatorOptions options;
+    bool formatGiven = false;
+    bool engineGiven = false;
+    bool queueDepthGiven = false;
+    bool submittersGiven = false;
+    string tuningPath;
+    string saveTuningPath;
+    vector<int> benchThreads;
+    vector<int> benchBuffers;
+    int benchRepeats = 3;
+    BatchPlan batchPlan;
+    string manifestPath;
+    bool checkpointGiven = false;
+    bool preallocGiven = false;
+    bool verifyOnly = false;
+    int adaptiveMax = 0;
     
-    if (argc >= 3) {
-        fileName = argv[1];
-        sizeInput = string(argv[2]) + (argc > 3 ? " " + string(argv[3]) : "");
+    // Split "--key=value" options from positional arguments
+    vector<string> positional;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg.compare(0, 2, "--") != 0) {
+            positional.push_back(arg);
+            continue;
+        }
         
-        if (argc >= 5) {
-            threads = atoi(argv[4]);
+        size_t eq = arg.find('=');
+        string key = arg.substr(2, eq == string::npos ? string::npos : eq - 2);
+        string value = eq == string::npos ? "" : arg.substr(eq + 1);
+        
+        if (key == "help") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (key == "random") {
+            randomData = true;
+        } else if (key == "seed") {
+            options.seed = strtoull(value.c_str(), nullptr, 0);
+        } else if (key == "engine") {
+            engineGiven = true;
+            if (value == "uring" || value == "io_uring") options.backend = WriteBackend::IoUring;
+            else if (value == "stream" || value == "ofstream") options.backend = WriteBackend::Stream;
+            else if (value == "mmap") options.backend = WriteBackend::Mmap;
+            else {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Unknown engine '" << value << "'\n" << Color::RESET;
+                return 1;
+            }
+        } else if (key == "msync") {
+            if (value == "none") options.msync = MsyncPolicy::None;
+            else if (value == "async") options.msync = MsyncPolicy::Async;
+            else if (value == "sync") options.msync = MsyncPolicy::Sync;
+            else {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Unknown msync policy '" << value << "'\n" << Color::RESET;
+                return 1;
+            }
+        } else if (key == "madvise") {
+            if (value == "normal") options.madvise = MadvisePolicy::Normal;
+            else if (value == "sequential") options.madvise = MadvisePolicy::Sequential;
+            else if (value == "hugepage") options.madvise = MadvisePolicy::HugePage;
+            else {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Unknown madvise policy '" << value << "'\n" << Color::RESET;
+                return 1;
+            }
+        } else if (key == "prealloc") {
+            preallocGiven = true;
+            if (value == "fallocate") options.prealloc = PreallocMode::Fallocate;
+            else if (value == "posix" || value == "posix_fallocate") options.prealloc = PreallocMode::PosixFallocate;
+            else if (value == "zero-range" || value == "zero") options.prealloc = PreallocMode::ZeroRange;
+            else if (value == "none") options.prealloc = PreallocMode::None;
+            else {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Unknown pre-allocation mode '" << value << "'\n" << Color::RESET;
+                return 1;
+            }
+        } else if (key == "format") {
+            formatGiven = true;
+            if (value == "json") options.format = OutputFormat::Json;
+            else if (value == "csv") options.format = OutputFormat::Csv;
+            else if (value == "text") options.format = OutputFormat::Text;
+            else {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Unknown format '" << value << "'\n" << Color::RESET;
+                return 1;
+            }
+        } else if (key == "progress-interval") {
+            options.progressInterval = max(0.0, atof(value.c_str()));
+        } else if (key == "metrics-file") {
+            options.metricsFile = value;
+        } else if (key == "metrics-listen") {
+            options.metricsListen = value;
+        } else if (key == "metrics-interval") {
+            options.metricsInterval = max(0.1, atof(value.c_str()));
+        } else if (key == "rate") {
+            options.rateLimit = parseRateInput(value);
+            if (options.rateLimit <= 0) {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Invalid rate '" << value << "' (e.g. 200MB/s)\n" << Color::RESET;
+                return 1;
+            }
+        } else if (key == "burst") {
+            options.rateBurst = parseSizeInput(value);
+        } else if (key == "rate-ramp") {
+            options.rateRamp = max(0.0, atof(value.c_str()));
+        } else if (key == "rate-profile") {
+            if (!loadRateProfile(value, options.rateProfile)) {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Cannot read rate profile '" << value << "'\n" << Color::RESET;
+                return 1;
+            }
+        } else if (key == "manifest") {
+            manifestPath = value;
+        } else if (key == "count") {
+            batchPlan.generatedCount = max(0LL, atoll(value.c_str()));
+        } else if (key == "sizes") {
+            if (!parseSizeMix(value, batchPlan)) {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Invalid size distribution '" << value << "'\n" << Color::RESET;
+                return 1;
+            }
+        } else if (key == "fanout") {
+            size_t x = value.find('x');
+            batchPlan.fanoutWidth = max(1, atoi(value.c_str()));
+            batchPlan.fanoutDepth = x == string::npos ? 1 : max(0, atoi(value.c_str() + x + 1));
+        } else if (key == "tuning") {
+            tuningPath = value;
+        } else if (key == "save-tuning") {
+            saveTuningPath = value;
+        } else if (key == "bench-threads") {
+            benchThreads = parseIntList(value);
+        } else if (key == "bench-buffers") {
+            benchBuffers = parseIntList(value);
+        } else if (key == "repeat") {
+            benchRepeats = atoi(value.c_str());
+        } else if (key == "verify") {
+            options.verifyAfterWrite = true;
+        } else if (key == "verify-only") {
+            verifyOnly = true;
+        } else if (key == "alloc-only") {
+            options.allocateOnly = true;
+        } else if (key == "cpus") {
+            options.cpus = CpuTopology::parse(value);
+            if (options.cpus.empty()) {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Invalid CPU list '" << value << "'\n" << Color::RESET;
+                return 1;
+            }
+        } else if (key == "numa-local") {
+            options.numaLocal = true;
+        } else if (key == "ioprio") {
+            string ioClass = value.substr(0, value.find(':'));
+            if (ioClass == "rt" || ioClass == "realtime") options.ioprioClass = 1;
+            else if (ioClass == "be" || ioClass == "best-effort") options.ioprioClass = 2;
+            else if (ioClass == "idle") options.ioprioClass = 3;
+            else {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Unknown I/O priority class '" << ioClass << "'\n" << Color::RESET;
+                return 1;
+            }
+            if (value.find(':') != string::npos) options.ioprioLevel = max(0, min(atoi(value.c_str() + value.find(':') + 1), 7));
+        } else if (key == "nice") {
+            options.niceness = max(-20, min(atoi(value.c_str()), 19));
+        } else if (key == "clone") {
+            options.cloneSeed = value.empty() ? 64LL * 1024 * 1024 : parseSizeInput(value);
+            if (options.cloneSeed <= 0) {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Invalid clone seed size '" << value << "'\n" << Color::RESET;
+                return 1;
+            }
+        } else if (key == "compress") {
+            options.compressRatio = max(1.0, atof(value.c_str()));
+            randomData = true;
+        } else if (key == "dedup") {
+            options.dedupRatio = max(1.0, atof(value.c_str()));
+            randomData = true;
+        } else if (key == "dedup-block") {
+            options.dedupBlock = parseSizeInput(value);
+            if (options.dedupBlock < 4096) {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Dedup chunk must be at least 4 KB\n" << Color::RESET;
+                return 1;
+            }
+        } else if (key == "adaptive") {
+            options.adaptive = true;
+            if (!value.empty()) adaptiveMax = max(1, min(atoi(value.c_str()), 256));
+        } else if (key == "targets") {
+            stringstream list(value);
+            string path;
+            while (getline(list, path, ',')) {
+                if (!path.empty()) options.stripeTargets.push_back(path);
+            }
+        } else if (key == "stripe-unit") {
+            options.stripeUnit = AlignedBuffer::alignDown(parseSizeInput(value));
+            if (options.stripeUnit <= 0) {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Stripe unit must be at least 4 KB\n" << Color::RESET;
+                return 1;
+            }
+        } else if (key == "stream-copy") {
+            options.streamCopy = true;
+        } else if (key == "checkpoint") {
+            checkpointGiven = true;
+            options.checkpointPath = value;
+        } else if (key == "resume") {
+            checkpointGiven = true;
+            options.resume = true;
+        } else if (key == "resume-verify") {
+            options.resumeVerifyUnits = max(0, atoi(value.c_str()));
+        } else if (key == "direct") {
+            options.directIO = true;
+        } else if (key == "qd") {
+            options.queueDepth = atoi(value.c_str());
+            queueDepthGiven = true;
+        } else if (key == "sync") {
+            if (value == "none") options.sync = SyncMode::None;
+            else if (value == "end") options.sync = SyncMode::End;
+            else if (value == "periodic") options.sync = SyncMode::Periodic;
+            else if (value == "rolling") options.sync = SyncMode::Rolling;
+            else {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Unknown sync mode '" << value << "'\n" << Color::RESET;
+                return 1;
+            }
+        } else if (key == "sync-every") {
+            options.syncEveryMB = atoi(value.c_str());
+        } else if (key == "pipeline") {
+            options.pipelineDepth = max(0, min(atoi(value.c_str()), 16));
+        } else if (key == "chunk") {
+            options.chunkMB = max(0, atoi(value.c_str()));
+        } else if (key == "submitters") {
+            options.submitters = atoi(value.c_str());
+            submittersGiven = true;
+        } else if (key == "read-pct") {
+            options.readPercent = max(0, min(atoi(value.c_str()), 100));
+        } else if (key == "bs") {
+            options.blockSize = parseSizeInput(value);
+            if (options.blockSize <= 0) {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Invalid block size '" << value << "'\n" << Color::RESET;
+                return 1;
+            }
+        } else if (key == "dist") {
+            string name = value.substr(0, value.find(':'));
+            if (name == "seq" || name == "sequential") options.distribution = OffsetDistribution::Sequential;
+            else if (name == "random" || name == "uniform") options.distribution = OffsetDistribution::Random;
+            else if (name == "zipf") options.distribution = OffsetDistribution::Zipf;
+            else {
+                cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Unknown distribution '" << name << "'\n" << Color::RESET;
+                return 1;
+            }
+            if (value.find(':') != string::npos) options.zipfTheta = atof(value.c_str() + value.find(':') + 1);
+        } else if (key == "duration") {
+            options.duration = max(0.0, atof(value.c_str()));
+        } else if (key == "ops") {
+            options.opLimit = max(0LL, atoll(value.c_str()));
+        } else {
+            cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Unknown option '" << arg << "'\n" << Color::RESET;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    // Streaming to stdout: the data owns the descriptor, so the UI and records move to stderr
+    bool streamToStdout = positional.size() >= 2 && positional[0] == "-";
+    if (streamToStdout) cout.rdbuf(cerr.rdbuf());
+    
+    // Scripts and pipes get machine-readable output unless a format was asked for
+    #ifdef _WIN32
+    bool stdoutIsTerminal = _isatty(_fileno(streamToStdout ? stderr : stdout)) != 0;
+    #else
+    bool stdoutIsTerminal = isatty(fileno(streamToStdout ? stderr : stdout)) != 0;
+    #endif
+    if (!formatGiven && !stdoutIsTerminal && (positional.size() >= 2 || verifyOnly)) {
+        options.format = OutputFormat::Json;
+    }
+    bool headless = options.format != OutputFormat::Text;
+    Dashboard dashboard;
+    options.view = &dashboard;
+    
+    // Bench sweep: a bounded sample per configuration against the target path
+    if (!positional.empty() && positional[0] == "bench") {
+        if (positional.size() < 2) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        
+        string sample = positional.size() >= 3 ? positional[2] + (positional.size() > 3 ? " " + positional[3] : "") : "256 MB";
+        long long sampleSize = parseSizeInput(sample);
+        if (sampleSize <= 0) {
+            cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Invalid size!\n" << Color::RESET;
+            return 1;
+        }
+        return runBench(positional[1], sampleSize, benchThreads, benchBuffers, benchRepeats, options, randomData, saveTuningPath);
+    }
+    
+    // A saved bench result fills in whatever the command line leaves unset
+    TuningProfile tuning;
+    bool tuned = !tuningPath.empty();
+    if (tuned && !tuning.load(tuningPath)) {
+        cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Cannot read tuning file '" << tuningPath << "'\n" << Color::RESET;
+        return 1;
+    }
+    if (tuned) {
+        threads = tuning.threads;
+        bufferMB = tuning.bufferMB;
+        // Queue depth and submitters were measured with the tuned engine, so they only follow it
+        if (!engineGiven) options.backend = tuning.backend;
+        if (options.backend == tuning.backend) {
+            if (!queueDepthGiven) options.queueDepth = tuning.queueDepth;
+            if (!submittersGiven && tuning.backend == WriteBackend::IoUring) options.submitters = tuning.threads;
+        }
+        // Tuned values were measured without the turbo minimums
+        turbo = false;
+    }
+    
+    // Batch mode: many files from a manifest or generator spec, one worker pool
+    if (!positional.empty() && positional[0] == "batch") {
+        if (positional.size() < 2 || (manifestPath.empty() && batchPlan.generatedCount == 0)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        
+        batchPlan.root = positional[1];
+        while (batchPlan.root.size() > 1 && batchPlan.root.back() == '/') batchPlan.root.pop_back();
+        batchPlan.seed = options.seed;
+        if (!manifestPath.empty() && !loadManifest(manifestPath, batchPlan)) {
+            cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Cannot read manifest '" << manifestPath << "'\n" << Color::RESET;
+            return 1;
+        }
+        
+        if (positional.size() >= 3) threads = max(1, min(atoi(positional[2].c_str()), 64));
+        if (positional.size() >= 4) bufferMB = max(1, min(atoi(positional[3].c_str()), 256));
+        if (threads == 0) threads = max(4, static_cast<int>(thread::hardware_concurrency()));
+        
+        JobSpec spec = cliJob(JobKind::Batch, batchPlan.root, 0, threads, bufferMB, randomData, turbo, options);
+        spec.batch = batchPlan;
+        bool succeeded = runJob(spec);
+        if (!headless && succeeded) {
+            cout << Color::BRIGHT_GREEN << Color::BOLD << "  🎉 SUCCESS! Batch created at maximum speed!\n\n" << Color::RESET;
+        }
+        return succeeded ? 0 : 1;
+    }
+    
+    // Standalone verify and workload runs: the size is whatever is on disk
+    bool workloadCommand = !verifyOnly && !positional.empty() && positional[0] == "workload";
+    if (verifyOnly || workloadCommand) {
+        size_t first = workloadCommand ? 1 : 0;
+        if (positional.size() < first + 1) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        
+        fileName = positional[first];
+        if (positional.size() >= first + 2) threads = max(1, min(atoi(positional[first + 1].c_str()), 64));
+        if (positional.size() >= first + 3) bufferMB = max(1, min(atoi(positional[first + 2].c_str()), 256));
+        
+        ifstream existing(fileName, ios::binary | ios::ate);
+        if (!existing) {
+            cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Cannot open '" << fileName << "'!\n" << Color::RESET;
+            return 1;
+        }
+        long long existingSize = static_cast<long long>(existing.tellg());
+        existing.close();
+        
+        JobKind kind = workloadCommand ? JobKind::Workload : JobKind::Verify;
+        return runJob(cliJob(kind, fileName, existingSize, threads, bufferMB, randomData, turbo, options)) ? 0 : 1;
+    }
+    
+    if (positional.size() >= 2) {
+        fileName = positional[0];
+        sizeInput = positional[1] + (positional.size() > 2 ? " " + positional[2] : "");
+        
+        if (positional.size() >= 4) {
+            threads = atoi(positional[3].c_str());
             if (threads < 1) threads = 1;
             if (threads > 64) threads = 64;
         }
         
-        if (argc >= 6) {
-            bufferMB = atoi(argv[5]);
+        if (positional.size() >= 5) {
+            bufferMB = atoi(positional[4].c_str());
             if (bufferMB < 1) bufferMB = 16;
             if (bufferMB > 256) bufferMB = 256;
         }
-        
-        if (argc >= 7 && string(argv[6]) == "--random") {
-            randomData = true;
-        }
     } else {
         cout << "\n";
         cout << Color::BOLD << Color::BRIGHT_MAGENTA;
@@ -655,13 +1693,25 @@ int main(int argc, char* argv[]) {
         randomData = (randomInput == "y" || randomInput == "Y");
     }
     
+    // Adaptive runs start from one writer, so a generous ceiling costs nothing until it helps
+    if (adaptiveMax > 0) threads = adaptiveMax;
     if (threads == 0) {
-        threads = max(4, static_cast<int>(thread::hardware_concurrency()));
+        threads = options.adaptive ? 32 : max(4, static_cast<int>(thread::hardware_concurrency()));
     }
     
-    long long fileSize = parseSizeInput(sizeInput);
+    // "-" is stdout; an unbounded size streams until the reader stops
+    options.stream = fileName == "-" || isFifo(fileName);
+    if (sizeInput.compare(0, 9, "unbounded") == 0 || sizeInput.compare(0, 3, "inf") == 0) {
+        if (!options.stream) {
+            cout << Color::BRIGHT_RED << "\n  ❌ ERROR: An unbounded size needs a stream target ('-' or a FIFO)!\n" << Color::RESET;
+            return 1;
+        }
+        options.unbounded = true;
+    }
+    
+    long long fileSize = options.unbounded ? 0 : parseSizeInput(sizeInput);
     
-    if (fileSize <= 0) {
+    if (fileSize <= 0 && !options.unbounded) {
         cout << Color::BRIGHT_RED << "\n  ❌ ERROR: Invalid size!\n" << Color::RESET;
         cout << Color::BRIGHT_YELLOW << "\n  📋 Examples:\n" << Color::RESET;
         cout << Color::WHITE << "    • 100 MB\n";
@@ -671,9 +1721,22 @@ int main(int argc, char* argv[]) {
         return 1;
     }
     
-    TurboFileCreator creator(fileName, fileSize, threads, bufferMB, randomData, turbo);
+    // Blocks allocated up front would only be replaced by shared extents
+    if (options.cloneSeed > 0 && !preallocGiven) options.prealloc = PreallocMode::None;
+    
+    // Nothing is written in metadata-only mode, so there is nothing to resume
+    if (checkpointGiven && !options.allocateOnly && options.checkpointPath.empty()) {
+        options.checkpointPath = fileName + ".ckpt";
+    }
+    if (options.allocateOnly) {
+        options.checkpointPath.clear();
+        options.resume = false;
+    }
+    
+    bool succeeded = runJob(cliJob(JobKind::Create, fileName, fileSize, threads, bufferMB, randomData, turbo, options));
+    if (headless) return succeeded ? 0 : 1;
     
-    if (creator.execute()) {
+    if (succeeded) {
         cout << Color::BRIGHT_GREEN << Color::BOLD << "  🎉 SUCCESS! File created at maximum speed!\n\n" << Color::RESET;
         return 0;
     } else {
@@ -0,0 +1,222 @@
+// Turbo File Creator batch mode
+// Creates a whole tree of files with one worker pool; file_creator_engine.hpp includes it
+#ifndef TURBO_FILE_CREATOR_BATCH_HPP
+#define TURBO_FILE_CREATOR_BATCH_HPP
+
+#include "file_creator_engine.hpp"
+
+namespace turbo {
+
+inline bool TurboFileCreator::makeDirectory(const string& path, bool& created) {
+    #ifdef _WIN32
+    created = CreateDirectoryA(path.c_str(), nullptr) != 0;
+    return created || GetLastError() == ERROR_ALREADY_EXISTS;
+    #else
+    created = mkdir(path.c_str(), 0755) == 0;
+    return created || errno == EEXIST;
+    #endif
+}
+
+// Claims runs of file indices and creates each one, timing open, writes and close apart
+inline void TurboFileCreator::batchWriter(int threadID) {
+    activeWorkers++;
+    placeWorker(threadID);
+    
+    try {
+        size_t bufSize = static_cast<size_t>(bufferSizeMB) * 1024 * 1024;
+        unique_ptr<AlignedBuffer> owned;
+        char* buffer = writerBuffer(owned, bufSize);
+        WorkerStats& mine = workerStats[threadID];
+        long long first, last;
+        
+        while (!errorFlag && scheduler.next(first, last)) {
+            for (long long index = first; index < last && !errorFlag; index++) {
+                string path = batch->pathOf(index);
+                long long size = batch->sizeOf(index);
+                // Each file has its own seed, so no two files share content whatever their size
+                PatternGenerator content = generator.reseeded(BatchPlan::mix(generator.seedValue() ^ static_cast<uint64_t>(index)));
+                
+                auto openStart = steady_clock::now();
+                #ifdef _WIN32
+                ofstream file(path, ios::binary | ios::trunc);
+                bool opened = file.is_open();
+                #else
+                int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+                bool opened = fd >= 0;
+                #endif
+                if (!opened) {
+                    noteFailure("Cannot create '" + path + "'", errno);
+                    break;
+                }
+                mine.openLatency.record(static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now() - openStart).count()));
+                
+                for (long long pos = 0; pos < size && !errorFlag; ) {
+                    size_t writeSize = static_cast<size_t>(min(static_cast<long long>(min(bufSize, pacedSlice)), size - pos));
+                    if (useRandomData) content.fill(buffer, writeSize, pos);
+                    limiter.acquire(static_cast<long long>(writeSize));
+                    
+                    auto writeStart = steady_clock::now();
+                    #ifdef _WIN32
+                    file.write(buffer, writeSize);
+                    bool ok = file.good();
+                    #else
+                    bool ok = pwriteAll(fd, buffer, writeSize, pos);
+                    #endif
+                    if (!ok) {
+                        noteFailure("Write to '" + path + "' failed", errno);
+                        break;
+                    }
+                    
+                    recordLatency(threadID, writeStart);
+                    recordWrite(threadID, writeSize);
+                    pos += writeSize;
+                }
+                
+                auto closeStart = steady_clock::now();
+                #ifdef _WIN32
+                file.close();
+                if (file.fail()) noteFailure("Cannot close '" + path + "'", errno);
+                #else
+                if (close(fd) != 0) noteFailure("Cannot close '" + path + "'", errno);
+                #endif
+                mine.closeLatency.record(static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now() - closeStart).count()));
+                mine.units++;
+            }
+        }
+    } catch (...) {
+        errorFlag = true;
+    }
+    
+    activeWorkers--;
+}
+
+inline long long TurboFileCreator::filesCreated() const {
+    long long files = 0;
+    for (int i = 0; i < workerStatsCount; i++) files += workerStats[i].units.load(memory_order_relaxed);
+    return files;
+}
+
+// Share of worker I/O time spent in each per-file phase
+inline void TurboFileCreator::batchPhaseShares(LatencyHistogram& opens, LatencyHistogram& closes, double& openPct, double& writePct, double& closePct) const {
+    LatencyHistogram writes;
+    for (int i = 0; i < workerStatsCount; i++) {
+        opens.merge(workerStats[i].openLatency);
+        closes.merge(workerStats[i].closeLatency);
+        writes.merge(workerStats[i].writeLatency);
+    }
+    double total = static_cast<double>(opens.sum() + writes.sum() + closes.sum());
+    openPct = total > 0 ? opens.sum() / total * 100 : 0;
+    writePct = total > 0 ? writes.sum() / total * 100 : 0;
+    closePct = total > 0 ? closes.sum() / total * 100 : 0;
+}
+
+inline bool TurboFileCreator::executeBatch(const BatchPlan& plan) {
+    batch = &plan;
+    
+    restrictCpus();
+    if (view()) view()->configured(*this);
+    reportPlacement();
+    MetricsSession metrics(*this);
+    
+    // Batch writers open, write and close each file with plain buffered calls
+    if (options.backend != WriteBackend::Stream) {
+        reportWarning(string("The ") + (options.backend == WriteBackend::IoUring ? "io_uring" : "mmap") + " engine does not apply to batch creation, using buffered writes");
+        options.backend = WriteBackend::Stream;
+    }
+    if (options.directIO) {
+        reportWarning("Direct I/O does not apply to batch creation, writing through the page cache");
+        options.directIO = false;
+    }
+    if (options.sync == SyncMode::Periodic || options.sync == SyncMode::Rolling) {
+        reportWarning("Batch creation syncs once at the end, --sync=" + syncName(options.sync) + " is not applied");
+        options.sync = SyncMode::End;
+    }
+    if (!options.checkpointPath.empty()) {
+        reportWarning("Checkpoints do not apply to batch creation, writing without one");
+        options.checkpointPath.clear();
+        options.resume = false;
+    }
+    if (options.cloneSeed > 0) {
+        reportWarning("Clone mode does not apply to batch creation, writing every file");
+        options.cloneSeed = 0;
+    }
+    if (options.adaptive) {
+        reportWarning("Adaptive concurrency applies to single-file runs, using a fixed count");
+        options.adaptive = false;
+    }
+    if (view()) view()->initializing(*this);
+    
+    // Directory tree first, so its metadata cost is reported apart from file creation
+    auto mkdirStart = steady_clock::now();
+    for (const string& dir : plan.directories()) {
+        bool created;
+        if (!makeDirectory(dir, created)) {
+            reportError("Cannot create directory '" + dir + "'");
+            return false;
+        }
+        if (created) directoriesCreated++;
+    }
+    mkdirTime = duration<double>(steady_clock::now() - mkdirStart).count();
+    
+    if (view()) view()->running(*this);
+    
+    long long files = plan.count();
+    int writers = numThreads;
+    workerStatsCount = writers;
+    workerStats.reset(new WorkerStats[writers]);
+    scheduler.reset(files, min(256LL, max(1LL, files / (static_cast<long long>(writers) * 64))));
+    prepareSharedBuffers();
+    limiter.start();
+    
+    auto startTime = steady_clock::now();
+    vector<thread> workers;
+    for (int i = 0; i < writers; i++) {
+        workers.emplace_back(&TurboFileCreator::batchWriter, this, i);
+    }
+    
+    double nextReport = options.progressInterval;
+    while (filesCreated() < files && !errorFlag) {
+        this_thread::sleep_for(milliseconds(50));
+        double elapsed = duration<double>(steady_clock::now() - startTime).count();
+        
+        trackProgress(bytesWritten.load(), fileSize, elapsed);
+        
+        if (headless() && options.progressInterval > 0 && elapsed >= nextReport) {
+            emitProgressRecord(bytesWritten.load(), elapsed);
+            nextReport += options.progressInterval;
+        }
+    }
+    
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+    
+    double totalTime = duration<double>(steady_clock::now() - startTime).count();
+    writeTime = totalTime;
+    if (view()) view()->stopped(*this);
+    reportPlacement();
+    
+    if (errorFlag) {
+        reportError(failureReason("Batch creation failed"));
+        return false;
+    }
+    
+    // One syncfs covers every file in the tree
+    #ifdef __linux__
+    auto flushStart = steady_clock::now();
+    int rootFd = options.sync == SyncMode::None ? -1 : open(fileName.c_str(), O_RDONLY | O_DIRECTORY);
+    if (rootFd >= 0) {
+        syncfs(rootFd);
+        close(rootFd);
+    }
+    flushTime = duration<double>(steady_clock::now() - flushStart).count();
+    #endif
+    
+    trackProgress(fileSize, fileSize, totalTime);
+    reportSummary(totalTime);
+    return true;
+}
+
+} // namespace turbo
+
+#endif // TURBO_FILE_CREATOR_BATCH_HPP
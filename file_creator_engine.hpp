@@ -0,0 +1,4277 @@
+// Turbo File Creator engine
+// Header-only: the writers, verification, workloads and the embedding API at the end of this file
+#ifndef TURBO_FILE_CREATOR_ENGINE_HPP
+#define TURBO_FILE_CREATOR_ENGINE_HPP
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <iomanip>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <cstring>
+#include <cstdlib>
+#include <new>
+#include <cerrno>
+#include <cstdint>
+#include <climits>
+#include <cctype>
+#include <csignal>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <future>
+
+#include "file_creator_metrics.hpp"
+#include "file_creator_stream.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#include <fcntl.h>
+#include <malloc.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#if defined(__has_include)
+#if __has_include(<linux/fs.h>)
+#include <linux/fs.h>
+#endif
+#endif
+#endif
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+#include <immintrin.h>
+#define TURBO_HAVE_SSE2 1
+#if defined(__GNUC__)
+#define TURBO_HAVE_AVX2 1
+#endif
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#define TURBO_HAVE_IO_URING 1
+#endif
+#endif
+
+// Everything below lives in turbo, so including the header adds no names to the global scope
+namespace turbo {
+
+using namespace std;
+using namespace std::chrono;
+
+// Advanced Statistics
+// Speed samples go into a fixed ring written only by the monitor, so recording never locks
+struct AdvancedStats {
+    static const size_t SAMPLE_CAPACITY = 4096;
+    
+    atomic<long long> totalBytes{0};
+    atomic<double> peakSpeed{0};
+    atomic<long long> operationCount{0};
+    double speedSamples[SAMPLE_CAPACITY] = {};
+    atomic<size_t> sampleCount{0};
+    double avgSpeed = 0;
+    double efficiency = 0;
+    
+    void recordSpeed(double speed) {
+        size_t count = sampleCount.load(memory_order_relaxed);
+        speedSamples[count % SAMPLE_CAPACITY] = speed;
+        sampleCount.store(count + 1, memory_order_release);
+        
+        double peak = peakSpeed.load();
+        while (speed > peak && !peakSpeed.compare_exchange_weak(peak, speed));
+        
+        double sum = 0;
+        size_t samples = min<size_t>(count + 1, 50);
+        for (size_t i = count + 1 - samples; i <= count; i++) {
+            sum += speedSamples[i % SAMPLE_CAPACITY];
+        }
+        avgSpeed = sum / samples;
+    }
+    
+    // Retained samples, oldest first
+    vector<double> recentSamples() const {
+        size_t count = sampleCount.load(memory_order_acquire);
+        size_t kept = min(count, static_cast<size_t>(SAMPLE_CAPACITY));
+        
+        vector<double> samples;
+        samples.reserve(kept);
+        for (size_t i = count - kept; i < count; i++) {
+            samples.push_back(speedSamples[i % SAMPLE_CAPACITY]);
+        }
+        return samples;
+    }
+};
+
+// HDR-style latency histogram: 16 sub-buckets per power of two, one writer, lock-free merge
+class LatencyHistogram {
+public:
+    static const int SUB_BITS = 4;
+    static const int SUB_COUNT = 1 << SUB_BITS;
+    static const int BUCKETS = (64 - SUB_BITS + 1) * SUB_COUNT;
+
+private:
+    atomic<uint64_t> counts[BUCKETS]{};
+    atomic<uint64_t> total{0};
+    atomic<uint64_t> sumValue{0};
+    atomic<uint64_t> maxValue{0};
+
+    static int highestBit(uint64_t value) {
+        #if defined(__GNUC__)
+        return 63 - __builtin_clzll(value);
+        #else
+        int bit = 0;
+        while (value >>= 1) bit++;
+        return bit;
+        #endif
+    }
+
+    static int bucketFor(uint64_t value) {
+        if (value < static_cast<uint64_t>(SUB_COUNT)) return static_cast<int>(value);
+        int shift = highestBit(value) - SUB_BITS;
+        return (shift + 1) * SUB_COUNT + static_cast<int>((value >> shift) & (SUB_COUNT - 1));
+    }
+
+    // Highest value that maps to the bucket, so percentiles never under-report
+    static uint64_t bucketUpperBound(int index) {
+        if (index < SUB_COUNT) return static_cast<uint64_t>(index);
+        int shift = index / SUB_COUNT - 1;
+        uint64_t lower = static_cast<uint64_t>(SUB_COUNT + index % SUB_COUNT) << shift;
+        return lower + ((1ULL << shift) - 1);
+    }
+
+    static void bump(atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(memory_order_relaxed) + amount, memory_order_relaxed);
+    }
+
+public:
+    // Single-writer only
+    void record(uint64_t nanos) {
+        bump(counts[bucketFor(nanos)], 1);
+        bump(total, 1);
+        bump(sumValue, nanos);
+        if (nanos > maxValue.load(memory_order_relaxed)) maxValue.store(nanos, memory_order_relaxed);
+    }
+
+    // Accumulates another histogram into this one; the target must not be shared with writers
+    void merge(const LatencyHistogram& other) {
+        for (int i = 0; i < BUCKETS; i++) {
+            uint64_t c = other.counts[i].load(memory_order_relaxed);
+            if (c) bump(counts[i], c);
+        }
+        bump(total, other.total.load(memory_order_relaxed));
+        bump(sumValue, other.sumValue.load(memory_order_relaxed));
+        maxValue.store(max(maxValue.load(memory_order_relaxed), other.maxValue.load(memory_order_relaxed)), memory_order_relaxed);
+    }
+
+    // Cumulative counts below each ascending limit; exact at powers of two
+    vector<uint64_t> countsBelow(const vector<uint64_t>& limits) const {
+        vector<uint64_t> below(limits.size(), 0);
+        uint64_t seen = 0;
+        size_t next = 0;
+        for (int i = 0; i < BUCKETS && next < limits.size(); i++) {
+            while (next < limits.size() && bucketUpperBound(i) >= limits[next]) below[next++] = seen;
+            seen += counts[i].load(memory_order_relaxed);
+        }
+        while (next < limits.size()) below[next++] = seen;
+        return below;
+    }
+
+    uint64_t count() const { return total.load(memory_order_relaxed); }
+    uint64_t maximum() const { return maxValue.load(memory_order_relaxed); }
+    uint64_t sum() const { return sumValue.load(memory_order_relaxed); }
+
+    uint64_t percentile(double pct) const {
+        uint64_t n = count();
+        if (n == 0) return 0;
+        
+        uint64_t target = max<uint64_t>(1, static_cast<uint64_t>(ceil(pct / 100.0 * n)));
+        uint64_t seen = 0;
+        for (int i = 0; i < BUCKETS; i++) {
+            seen += counts[i].load(memory_order_relaxed);
+            if (seen >= target) return min(bucketUpperBound(i), maximum());
+        }
+        return maximum();
+    }
+};
+
+// Per-worker counters, padded to a cache line so neighbouring writers never share one
+struct alignas(64) WorkerStats {
+    atomic<long long> bytes{0};
+    atomic<long long> units{0};
+    LatencyHistogram writeLatency;
+    atomic<long long> generateNanos{0};     // Time spent filling buffers with random data
+    atomic<long long> generateStallNanos{0};    // Pipeline: generator waiting for a free buffer
+    atomic<long long> writeStallNanos{0};       // Pipeline: writer waiting for a filled buffer
+    LatencyHistogram readLatency;   // Workload mode: pread per block
+    atomic<long long> readBytes{0};
+    LatencyHistogram openLatency;   // Batch mode: open(O_CREAT) per file
+    LatencyHistogram closeLatency;  // Batch mode: close() per file
+    
+    // In-run durability (--sync=periodic|rolling)
+    atomic<long long> syncNanos{0};
+    int syncFd = -1;
+    long long pendingOffset = 0;    // Rolling: block whose writeback was started but not awaited
+    long long pendingLength = 0;
+    
+    ~WorkerStats() {
+        #ifndef _WIN32
+        if (syncFd >= 0) close(syncFd);
+        #endif
+    }
+    
+    // Allocated as arrays; keeps the cache-line alignment before C++17's aligned new
+    static void* operator new[](size_t size) {
+        #ifdef _WIN32
+        void* memory = _aligned_malloc(size, alignof(WorkerStats));
+        #else
+        void* memory = nullptr;
+        if (posix_memalign(&memory, alignof(WorkerStats), size) != 0) memory = nullptr;
+        #endif
+        if (!memory) throw bad_alloc();
+        return memory;
+    }
+    
+    static void operator delete[](void* memory) {
+        #ifdef _WIN32
+        _aligned_free(memory);
+        #else
+        free(memory);
+        #endif
+    }
+};
+
+// Dynamic Work Distribution
+// Workers claim fixed-size units from a shared cursor, so a slow region only delays its own thread
+class ChunkScheduler {
+private:
+    atomic<long long> cursor{0};
+    long long totalSize = 0;
+    long long unitSize = 1;
+    const vector<bool>* skipUnits = nullptr;
+
+public:
+    void reset(long long total, long long unit, const vector<bool>* skip = nullptr) {
+        totalSize = total;
+        unitSize = max(1LL, unit);
+        skipUnits = skip;
+        cursor = 0;
+    }
+
+    bool next(long long& start, long long& end) {
+        long long claimed = cursor.fetch_add(unitSize, memory_order_relaxed);
+        // Units finished by an earlier, interrupted run are passed over
+        while (skipUnits && claimed < totalSize && (*skipUnits)[claimed / unitSize]) {
+            claimed = cursor.fetch_add(unitSize, memory_order_relaxed);
+        }
+        if (claimed >= totalSize) return false;
+        
+        start = claimed;
+        end = min(totalSize, claimed + unitSize);
+        return true;
+    }
+
+    long long unit() const { return unitSize; }
+    bool drained() const { return cursor.load(memory_order_relaxed) >= totalSize; }
+};
+
+// Resume Checkpoint
+// One bit per written unit; a saver thread stores it through a temp file and a rename
+class Checkpoint {
+private:
+    string path;
+    long long fileSize = 0;
+    long long unitSize = 0;
+    uint64_t seed = 0;
+    bool random = false;
+    long long units = 0;
+    unique_ptr<atomic<uint64_t>[]> bits;
+
+    static string header(long long size, long long unit, uint64_t seedValue, bool randomData) {
+        stringstream ss;
+        ss << "TFCKPT1 " << size << " " << unit << " " << seedValue << " " << (randomData ? 1 : 0) << "\n";
+        return ss.str();
+    }
+
+    size_t wordCount() const { return static_cast<size_t>((units + 63) / 64); }
+
+public:
+    void init(const string& file, long long size, long long unit, uint64_t seedValue, bool randomData) {
+        path = file;
+        fileSize = size;
+        unitSize = unit;
+        seed = seedValue;
+        random = randomData;
+        units = (size + unit - 1) / unit;
+        bits.reset(new atomic<uint64_t>[wordCount()]);
+        for (size_t i = 0; i < wordCount(); i++) bits[i] = 0;
+    }
+
+    bool active() const { return static_cast<bool>(bits); }
+    long long unit() const { return unitSize; }
+    long long unitCount() const { return units; }
+    const string& location() const { return path; }
+
+    void markDone(long long unitIndex) {
+        bits[unitIndex / 64].fetch_or(1ULL << (unitIndex % 64), memory_order_relaxed);
+    }
+
+    void clear(long long unitIndex) {
+        bits[unitIndex / 64].fetch_and(~(1ULL << (unitIndex % 64)), memory_order_relaxed);
+    }
+
+    bool isDone(long long unitIndex) const {
+        return (bits[unitIndex / 64].load(memory_order_relaxed) >> (unitIndex % 64)) & 1;
+    }
+
+    long long doneBytes() const {
+        long long total = 0;
+        for (long long i = 0; i < units; i++) {
+            if (isDone(i)) total += min(unitSize, fileSize - i * unitSize);
+        }
+        return total;
+    }
+
+    vector<bool> doneUnits() const {
+        vector<bool> done(static_cast<size_t>(units));
+        for (long long i = 0; i < units; i++) done[i] = isDone(i);
+        return done;
+    }
+
+    // Taken before the data is flushed, so a saved bitmap never claims more than reached the device
+    vector<uint64_t> snapshot() const {
+        vector<uint64_t> state(wordCount());
+        for (size_t i = 0; i < state.size(); i++) state[i] = bits[i].load(memory_order_relaxed);
+        return state;
+    }
+
+    // The temp file reaches the device before the rename, and the rename before save returns
+    bool save(const vector<uint64_t>& state) const {
+        string temp = path + ".tmp";
+        string content = header(fileSize, unitSize, seed, random);
+        content.append(reinterpret_cast<const char*>(state.data()), state.size() * sizeof(uint64_t));
+        
+        #ifdef _WIN32
+        {
+            ofstream out(temp, ios::binary | ios::trunc);
+            if (!out) return false;
+            out.write(content.data(), static_cast<streamsize>(content.size()));
+            if (!out.good()) return false;
+        }
+        return MoveFileExA(temp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+        #else
+        int fd = open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        bool ok = true;
+        for (size_t done = 0; ok && done < content.size(); ) {
+            ssize_t n = write(fd, content.data() + done, content.size() - done);
+            if (n < 0 && errno == EINTR) continue;
+            ok = n > 0;
+            if (ok) done += static_cast<size_t>(n);
+        }
+        ok = fsync(fd) == 0 && ok;
+        ok = close(fd) == 0 && ok;
+        if (!ok || rename(temp.c_str(), path.c_str()) != 0) {
+            remove(temp.c_str());
+            return false;
+        }
+        
+        size_t slash = path.rfind('/');
+        string dir = slash == string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+        int dirFd = open(dir.c_str(), O_RDONLY);
+        if (dirFd >= 0) {
+            fsync(dirFd);
+            close(dirFd);
+        }
+        return true;
+        #endif
+    }
+
+    // A checkpoint from a different size, seed or data mode describes other content and is rejected
+    bool load(const string& file, long long size, uint64_t seedValue, bool randomData, string& error) {
+        ifstream in(file, ios::binary);
+        if (!in) {
+            error = "No checkpoint at '" + file + "'";
+            return false;
+        }
+        
+        string magic;
+        long long savedSize, savedUnit;
+        uint64_t savedSeed;
+        int savedRandom;
+        in >> magic >> savedSize >> savedUnit >> savedSeed >> savedRandom;
+        in.get();
+        if (magic != "TFCKPT1" || savedUnit <= 0) {
+            error = "'" + file + "' is not a checkpoint";
+            return false;
+        }
+        if (savedSize != size || savedRandom != (randomData ? 1 : 0) || (randomData && savedSeed != seedValue)) {
+            error = "Checkpoint was written for a different size, seed or data pattern";
+            return false;
+        }
+        
+        init(file, size, savedUnit, seedValue, randomData);
+        for (size_t i = 0; i < wordCount(); i++) {
+            uint64_t word = 0;
+            in.read(reinterpret_cast<char*>(&word), sizeof(word));
+            bits[i] = word;
+        }
+        if (!in) {
+            error = "Checkpoint '" + file + "' is truncated";
+            return false;
+        }
+        return true;
+    }
+
+    void discard() const {
+        remove(path.c_str());
+    }
+};
+
+// CPU / NUMA Topology
+// Node layout from sysfs; hosts without it report a single node
+class CpuTopology {
+    // Reads one CPU number, leaving `end` after its digits; false unless it is in [0, MAX_CPUS)
+    static bool parseCpu(const char* text, const char*& end, long& cpu) {
+        if (!isdigit(static_cast<unsigned char>(*text))) return false;
+        char* stop = nullptr;
+        errno = 0;
+        cpu = strtol(text, &stop, 10);
+        end = stop;
+        return errno == 0 && cpu < MAX_CPUS;
+    }
+
+public:
+    #ifdef CPU_SETSIZE
+    static const int MAX_CPUS = CPU_SETSIZE;
+    #else
+    static const int MAX_CPUS = 1024;
+    #endif
+
+    // "0-3,8,10-11" -> {0,1,2,3,8,10,11}; an empty result means the list was malformed
+    static vector<int> parse(const string& input) {
+        vector<int> cpus;
+        stringstream ss(input);
+        string item;
+        while (getline(ss, item, ',')) {
+            const char* end = item.c_str();
+            long first, last;
+            if (!parseCpu(end, end, first)) return vector<int>();
+            last = first;
+            if (*end == '-' && !parseCpu(end + 1, end, last)) return vector<int>();
+            if (*end != '\0' || last < first) return vector<int>();
+            for (long cpu = first; cpu <= last; cpu++) cpus.push_back(static_cast<int>(cpu));
+        }
+        return cpus;
+    }
+
+    static string format(const vector<int>& cpus) {
+        stringstream ss;
+        for (size_t i = 0; i < cpus.size(); ) {
+            size_t j = i;
+            while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) j++;
+            if (i > 0) ss << ",";
+            ss << cpus[i];
+            if (j > i) ss << "-" << cpus[j];
+            i = j + 1;
+        }
+        return ss.str();
+    }
+
+    static int nodeCount() {
+        #ifdef __linux__
+        int nodes = 0;
+        while (access(("/sys/devices/system/node/node" + to_string(nodes)).c_str(), F_OK) == 0) nodes++;
+        return max(1, nodes);
+        #else
+        return 1;
+        #endif
+    }
+
+    static int nodeOf(int cpu) {
+        #ifdef __linux__
+        string base = "/sys/devices/system/cpu/cpu" + to_string(cpu) + "/node";
+        for (int node = 0; node < 256; node++) {
+            if (access((base + to_string(node)).c_str(), F_OK) == 0) return node;
+        }
+        #endif
+        (void)cpu;
+        return 0;
+    }
+
+    // CPUs this process may run on; pinning to anything else fails
+    static vector<int> allowed() {
+        vector<int> cpus;
+        #ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+            for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+                if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+            }
+            return cpus;
+        }
+        #endif
+        for (unsigned cpu = 0; cpu < max(1u, thread::hardware_concurrency()); cpu++) cpus.push_back(static_cast<int>(cpu));
+        return cpus;
+    }
+};
+
+// Single-producer/single-consumer ring of buffer indices between a generator and its writer
+class SpscRing {
+private:
+    vector<unsigned> slots;
+    alignas(64) atomic<size_t> head{0};
+    alignas(64) atomic<size_t> tail{0};
+
+public:
+    explicit SpscRing(size_t capacity) : slots(capacity) {}
+
+    bool push(unsigned value) {
+        size_t t = tail.load(memory_order_relaxed);
+        if (t - head.load(memory_order_acquire) == slots.size()) return false;
+        slots[t % slots.size()] = value;
+        tail.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    bool pop(unsigned& value) {
+        size_t h = head.load(memory_order_relaxed);
+        if (h == tail.load(memory_order_acquire)) return false;
+        value = slots[h % slots.size()];
+        head.store(h + 1, memory_order_release);
+        return true;
+    }
+};
+
+// One entry of a step schedule: from atSeconds on, the target is bytesPerSec
+struct RateStep {
+    double atSeconds;
+    double bytesPerSec;
+};
+
+// Throughput Shaping
+// Token bucket shared by all writers; each sleeps exactly as long as its own deficit needs
+class RateLimiter {
+private:
+    mutex lock;
+    double baseRate = 0;
+    double burstBytes = 0;
+    double rampSeconds = 0;
+    vector<RateStep> steps;
+    
+    double credited = 0;
+    double consumed = 0;
+    steady_clock::time_point startTime;
+    steady_clock::time_point lastRefill;
+    bool active = false;
+    atomic<bool> aborted{false};
+
+    void refill(steady_clock::time_point now) {
+        double dt = duration<double>(now - lastRefill).count();
+        if (dt <= 0) return;
+        
+        double t = duration<double>(now - startTime).count() - dt / 2;
+        credited = min(credited + rateAt(t) * dt, consumed + burstBytes);
+        lastRefill = now;
+    }
+
+public:
+    void configure(double rate, double burst, double ramp, const vector<RateStep>& schedule) {
+        baseRate = rate;
+        rampSeconds = max(0.0, ramp);
+        steps = schedule;
+        sort(steps.begin(), steps.end(), [](const RateStep& a, const RateStep& b) { return a.atSeconds < b.atSeconds; });
+        active = baseRate > 0 || !steps.empty();
+        
+        // Default burst: 100 ms at the highest scheduled rate
+        double peak = baseRate;
+        for (const auto& step : steps) peak = max(peak, step.bytesPerSec);
+        burstBytes = burst > 0 ? burst : peak * 0.1;
+    }
+
+    void start() {
+        startTime = lastRefill = steady_clock::now();
+        credited = burstBytes;
+        consumed = 0;
+    }
+
+    // Releases every waiting and future caller, so a cancelled run is not held up by its schedule
+    void abort() { aborted = true; }
+
+    bool enabled() const { return active; }
+    double burst() const { return burstBytes; }
+    double ramp() const { return rampSeconds; }
+    bool scheduled() const { return !steps.empty(); }
+
+    // Target rate t seconds into the run
+    double rateAt(double t) const {
+        double rate = baseRate;
+        if (!steps.empty()) {
+            rate = steps.front().bytesPerSec;
+            for (const auto& step : steps) {
+                if (step.atSeconds > t) break;
+                rate = step.bytesPerSec;
+            }
+        }
+        if (rampSeconds > 0 && t < rampSeconds) rate *= max(0.0, t) / rampSeconds;
+        return rate;
+    }
+
+    // Mean target over [0, t], used to score how closely the run tracked the schedule
+    double meanRate(double t) const {
+        if (t <= 0) return rateAt(0);
+        const int SAMPLES = 1000;
+        double sum = 0;
+        for (int i = 0; i < SAMPLES; i++) sum += rateAt((i + 0.5) * t / SAMPLES);
+        return sum / SAMPLES;
+    }
+
+    double currentRate() const {
+        return rateAt(duration<double>(steady_clock::now() - startTime).count());
+    }
+
+    void acquire(long long bytes) {
+        if (!active || aborted) return;
+        
+        double ticket;
+        {
+            lock_guard<mutex> guard(lock);
+            refill(steady_clock::now());
+            consumed += bytes;
+            ticket = consumed;
+        }
+        
+        while (true) {
+            double wait;
+            {
+                lock_guard<mutex> guard(lock);
+                auto now = steady_clock::now();
+                refill(now);
+                if (credited >= ticket || aborted) return;
+                
+                // A paused step (rate 0) or the start of a ramp gives no estimate, so re-check shortly
+                double rate = rateAt(duration<double>(now - startTime).count());
+                wait = rate > 0 ? (ticket - credited) / rate : 0.01;
+            }
+            this_thread::sleep_for(duration<double>(min(wait, 0.05)));
+        }
+    }
+};
+
+// Adaptive Concurrency
+// Hill-climbs the active writer count: doubles while throughput improves, then bisects and holds
+class ConcurrencyController {
+public:
+    struct Decision {
+        double atSeconds;
+        int from;
+        int to;
+        double rate;        // Throughput measured with `from` writers
+        string reason;
+    };
+
+private:
+    enum class Phase { Probe, Refine, Settled };
+    Phase phase = Phase::Probe;
+    int ceiling = 1;
+    int current = 1;
+    int best = 1;
+    double bestRate = 0;
+    int worse = 1;          // Refine: nearest count known to be no better than best
+    int slowWindows = 0;
+    bool measuring = false;
+    double changedAt = 0;
+    double windowStart = 0;
+    long long windowBytes = 0;
+    vector<Decision> log;
+
+    // Next count between best and worse, or best itself once they are adjacent
+    int bisect() const {
+        return abs(worse - best) <= 1 ? best : (best + worse) / 2;
+    }
+
+public:
+    void start(int maxWriters) {
+        ceiling = max(1, maxWriters);
+        current = best = worse = 1;
+        phase = Phase::Probe;
+    }
+
+    int writers() const { return current; }
+    bool settled() const { return phase == Phase::Settled; }
+    const vector<Decision>& decisions() const { return log; }
+
+    // Feeds elapsed time and bytes written so far; true when a decision was made
+    bool sample(double now, long long bytes, Decision& decision) {
+        const double WARMUP = 0.5, WINDOW = 1.0, GAIN = 1.05, DROP = 0.7;
+        if (!measuring) {
+            if (now - changedAt < WARMUP) return false;
+            measuring = true;
+            windowStart = now;
+            windowBytes = bytes;
+            return false;
+        }
+        if (now - windowStart < WINDOW) return false;
+        double rate = (bytes - windowBytes) / (now - windowStart);
+        measuring = false;
+        
+        int next = current;
+        string reason;
+        if (phase == Phase::Probe) {
+            if (rate > bestRate * GAIN) {
+                best = current;
+                bestRate = rate;
+                if (current < ceiling) {
+                    next = min(ceiling, current * 2);
+                    reason = "gained, doubling";
+                } else {
+                    phase = Phase::Settled;
+                    reason = "gained up to the ceiling, holding";
+                }
+            } else {
+                worse = current;
+                phase = Phase::Refine;
+                next = bisect();
+                reason = "no gain over " + to_string(best) + ", refining";
+            }
+        } else if (phase == Phase::Refine) {
+            bool gained = rate > bestRate * GAIN;
+            if (gained) {
+                best = current;
+                bestRate = rate;
+            } else {
+                worse = current;
+            }
+            next = bisect();
+            reason = gained ? "gained, refining" : "no gain, refining";
+        } else {
+            slowWindows = rate < bestRate * DROP ? slowWindows + 1 : 0;
+            if (slowWindows < 3) return false;
+            // The device or the competing load changed: search again from the current count
+            slowWindows = 0;
+            phase = Phase::Probe;
+            best = current;
+            bestRate = rate;
+            next = current < ceiling ? min(ceiling, current * 2) : max(1, current / 2);
+            reason = "throughput dropped, probing again";
+        }
+        if (phase == Phase::Refine && next == best) {
+            phase = Phase::Settled;
+            reason = "settled on the best count";
+        }
+        
+        decision.atSeconds = now;
+        decision.from = current;
+        decision.to = next;
+        decision.rate = rate;
+        decision.reason = reason;
+        log.push_back(decision);
+        current = next;
+        changedAt = now;
+        return true;
+    }
+};
+
+// Machine-readable Output
+// One flat record, printed as a JSON line or a CSV row
+class StructuredRecord {
+private:
+    struct Field {
+        string key;
+        string value;
+        bool quoted;
+    };
+    vector<Field> fields;
+
+    static string jsonEscape(const string& text) {
+        stringstream out;
+        for (unsigned char c : text) {
+            if (c == '"' || c == '\\') out << '\\' << c;
+            else if (c < 0x20) out << "\\u" << hex << setw(4) << setfill('0') << static_cast<int>(c) << dec << setfill(' ');
+            else out << c;
+        }
+        return out.str();
+    }
+
+    static string csvEscape(const string& text) {
+        if (text.find_first_of(",\"\n") == string::npos) return text;
+        string out = "\"";
+        for (char c : text) out += (c == '"') ? string("\"\"") : string(1, c);
+        return out + "\"";
+    }
+
+public:
+    explicit StructuredRecord(const string& type) {
+        addText("type", type);
+    }
+
+    const string& type() const { return fields.front().value; }
+
+    StructuredRecord& addText(const string& key, const string& value) {
+        fields.push_back({key, value, true});
+        return *this;
+    }
+
+    StructuredRecord& addInt(const string& key, long long value) {
+        fields.push_back({key, to_string(value), false});
+        return *this;
+    }
+
+    StructuredRecord& addNumber(const string& key, double value, int precision = 3) {
+        stringstream ss;
+        ss << fixed << setprecision(precision) << (isfinite(value) ? value : 0.0);
+        fields.push_back({key, ss.str(), false});
+        return *this;
+    }
+
+    StructuredRecord& addBool(const string& key, bool value) {
+        fields.push_back({key, value ? "true" : "false", false});
+        return *this;
+    }
+
+    string json() const {
+        stringstream out;
+        out << "{";
+        for (size_t i = 0; i < fields.size(); i++) {
+            if (i) out << ",";
+            out << "\"" << fields[i].key << "\":";
+            if (fields[i].quoted) out << "\"" << jsonEscape(fields[i].value) << "\"";
+            else out << fields[i].value;
+        }
+        out << "}";
+        return out.str();
+    }
+
+    string csvHeader() const {
+        string out;
+        for (size_t i = 0; i < fields.size(); i++) out += (i ? "," : "") + fields[i].key;
+        return out;
+    }
+
+    string csvRow() const {
+        string out;
+        for (size_t i = 0; i < fields.size(); i++) out += (i ? "," : "") + csvEscape(fields[i].value);
+        return out;
+    }
+};
+
+// Page-aligned, zero-initialized heap buffer usable for O_DIRECT transfers
+class AlignedBuffer {
+private:
+    char* ptr = nullptr;
+    size_t length = 0;
+    size_t mappedLength = 0;
+    size_t trackedLength = 0;
+
+    void track(size_t bytes) {
+        trackedLength = bytes;
+        long long now = usage().live += static_cast<long long>(bytes);
+        long long peak = usage().peak.load();
+        while (now > peak && !usage().peak.compare_exchange_weak(peak, now));
+    }
+
+public:
+    static const size_t ALIGNMENT = 4096;
+
+    // Process-wide buffer accounting for the final report
+    struct Usage {
+        atomic<long long> live{0};
+        atomic<long long> peak{0};
+        atomic<long long> hugeTlb{0};   // Bytes ever backed by reserved huge pages
+        atomic<long long> thp{0};       // Bytes ever mapped with a transparent hugepage hint
+    };
+
+    static Usage& usage() {
+        static Usage counters;
+        return counters;
+    }
+
+    // Large buffers come from anonymous mappings, with huge pages where reserved or a THP hint
+    explicit AlignedBuffer(size_t size) : length(size) {
+        size_t padded = (max<size_t>(size, 1) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        #ifdef __linux__
+        const size_t HUGE_PAGE = 2 * 1024 * 1024;
+        if (size >= HUGE_PAGE) {
+            size_t rounded = (size + HUGE_PAGE - 1) & ~(HUGE_PAGE - 1);
+            void* mem = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (mem != MAP_FAILED) {
+                usage().hugeTlb += rounded;
+            } else {
+                mem = mmap(nullptr, rounded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (mem == MAP_FAILED) throw bad_alloc();
+                if (madvise(mem, rounded, MADV_HUGEPAGE) == 0) usage().thp += rounded;
+            }
+            ptr = static_cast<char*>(mem);
+            mappedLength = rounded;
+            track(rounded);
+            return;
+        }
+        #endif
+        #ifdef _WIN32
+        ptr = static_cast<char*>(_aligned_malloc(padded, ALIGNMENT));
+        if (!ptr) throw bad_alloc();
+        #else
+        void* mem = nullptr;
+        if (posix_memalign(&mem, ALIGNMENT, padded) != 0) throw bad_alloc();
+        ptr = static_cast<char*>(mem);
+        #endif
+        memset(ptr, 0, padded);
+        track(padded);
+    }
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    ~AlignedBuffer() {
+        usage().live -= static_cast<long long>(trackedLength);
+        #ifndef _WIN32
+        if (mappedLength) {
+            munmap(ptr, mappedLength);
+            return;
+        }
+        #endif
+        #ifdef _WIN32
+        _aligned_free(ptr);
+        #else
+        free(ptr);
+        #endif
+    }
+
+    char* data() { return ptr; }
+    const char* data() const { return ptr; }
+    size_t size() const { return length; }
+
+    static long long alignDown(long long value) {
+        return value & ~static_cast<long long>(ALIGNMENT - 1);
+    }
+};
+
+// Walks a claimed unit in buffer-sized blocks; splitTail gives the sub-4 KB tail a block of its own
+class BlockCursor {
+private:
+    long long pos;
+    long long alignedEnd;
+    long long end;
+    size_t blockSize;
+
+public:
+    BlockCursor(long long start, long long stop, size_t size, bool splitTail)
+        : pos(start), alignedEnd(splitTail ? max(start, AlignedBuffer::alignDown(stop)) : stop), end(stop), blockSize(size) {}
+
+    bool next(long long& offset, size_t& length) {
+        if (pos >= end) return false;
+        long long limit = pos < alignedEnd ? alignedEnd : end;
+        offset = pos;
+        length = static_cast<size_t>(min(static_cast<long long>(blockSize), limit - pos));
+        pos += length;
+        return true;
+    }
+};
+
+// Counter-based Pseudo-Random Data
+// Each block is a pure function of (seed, block index), identical from the scalar, SSE2 and AVX2 paths
+class PatternGenerator {
+public:
+    static const size_t BLOCK = 4096;
+    static const size_t WORDS = BLOCK / sizeof(uint64_t);
+
+private:
+    typedef void (*BlockFn)(uint64_t state[16], uint64_t* out);
+
+    uint64_t seed;
+    BlockFn blockFn;
+    const char* isa;
+    
+    // Data reduction shaping; the defaults keep every block unique and incompressible
+    size_t literalBytes = BLOCK;    // Random prefix of each block; the rest of the block repeats it
+    uint64_t chunkBlocks = 1;       // Blocks per dedup chunk
+    uint64_t groupChunks = 0;       // Chunks per dedup group (a power of two); 0 disables dedup
+    uint64_t uniqueChunks = 0;      // Distinct chunks per group
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // State layout is word-major: state[k * 4 + lane] holds s[k] of that lane
+    void seedBlock(uint64_t blockIndex, uint64_t state[16]) const {
+        uint64_t x = seed ^ (blockIndex * 0xD1B54A32D192ED03ULL);
+        for (int i = 0; i < 16; i++) state[i] = splitmix64(x);
+    }
+
+    static void blockScalar(uint64_t state[16], uint64_t* out) {
+        for (size_t i = 0; i < WORDS; i += 4) {
+            for (int lane = 0; lane < 4; lane++) {
+                uint64_t& s0 = state[lane];
+                uint64_t& s1 = state[4 + lane];
+                uint64_t& s2 = state[8 + lane];
+                uint64_t& s3 = state[12 + lane];
+                
+                out[i + lane] = s0 + s3;
+                uint64_t t = s1 << 17;
+                s2 ^= s0;
+                s3 ^= s1;
+                s1 ^= s2;
+                s0 ^= s3;
+                s2 ^= t;
+                s3 = (s3 << 45) | (s3 >> 19);
+            }
+        }
+    }
+
+#ifdef TURBO_HAVE_SSE2
+    static void blockSSE2(uint64_t state[16], uint64_t* out) {
+        // Two registers per state word cover lanes 0-1 and 2-3
+        __m128i s[4][2];
+        for (int k = 0; k < 4; k++) {
+            s[k][0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + k * 4));
+            s[k][1] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(state + k * 4 + 2));
+        }
+        
+        for (size_t i = 0; i < WORDS; i += 4) {
+            for (int h = 0; h < 2; h++) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + h * 2), _mm_add_epi64(s[0][h], s[3][h]));
+                __m128i t = _mm_slli_epi64(s[1][h], 17);
+                s[2][h] = _mm_xor_si128(s[2][h], s[0][h]);
+                s[3][h] = _mm_xor_si128(s[3][h], s[1][h]);
+                s[1][h] = _mm_xor_si128(s[1][h], s[2][h]);
+                s[0][h] = _mm_xor_si128(s[0][h], s[3][h]);
+                s[2][h] = _mm_xor_si128(s[2][h], t);
+                s[3][h] = _mm_or_si128(_mm_slli_epi64(s[3][h], 45), _mm_srli_epi64(s[3][h], 19));
+            }
+        }
+        
+        for (int k = 0; k < 4; k++) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(state + k * 4), s[k][0]);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(state + k * 4 + 2), s[k][1]);
+        }
+    }
+#endif
+
+#ifdef TURBO_HAVE_AVX2
+    __attribute__((target("avx2")))
+    static void blockAVX2(uint64_t state[16], uint64_t* out) {
+        __m256i s0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state));
+        __m256i s1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 4));
+        __m256i s2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 8));
+        __m256i s3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state + 12));
+        
+        for (size_t i = 0; i < WORDS; i += 4) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi64(s0, s3));
+            __m256i t = _mm256_slli_epi64(s1, 17);
+            s2 = _mm256_xor_si256(s2, s0);
+            s3 = _mm256_xor_si256(s3, s1);
+            s1 = _mm256_xor_si256(s1, s2);
+            s0 = _mm256_xor_si256(s0, s3);
+            s2 = _mm256_xor_si256(s2, t);
+            s3 = _mm256_or_si256(_mm256_slli_epi64(s3, 45), _mm256_srli_epi64(s3, 19));
+        }
+        
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(state), s0);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 4), s1);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 8), s2);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(state + 12), s3);
+    }
+#endif
+
+    void generateBlock(uint64_t blockIndex, char* out) const {
+        uint64_t state[16];
+        seedBlock(blockIndex, state);
+        
+        // Blocks are generated in whole words; aligned stores are not required
+        uint64_t words[WORDS];
+        uint64_t* target = (reinterpret_cast<uintptr_t>(out) % alignof(uint64_t) == 0) ? reinterpret_cast<uint64_t*>(out) : words;
+        blockFn(state, target);
+        if (target == words) memcpy(out, words, BLOCK);
+    }
+
+    // Block whose random content blockIndex carries; duplicates copy one of the group's unique chunks
+    uint64_t contentOf(uint64_t blockIndex) const {
+        if (groupChunks == 0) return blockIndex;
+        uint64_t chunk = blockIndex / chunkBlocks;
+        uint64_t slot = (chunk * 0x9E3779B1ULL) & (groupChunks - 1);
+        if (slot >= uniqueChunks) {
+            uint64_t x = chunk;
+            slot = splitmix64(x) % uniqueChunks;
+        }
+        return ((chunk & ~(groupChunks - 1)) + slot) * chunkBlocks + blockIndex % chunkBlocks;
+    }
+
+    void produceBlock(uint64_t blockIndex, char* out) const {
+        generateBlock(contentOf(blockIndex), out);
+        // Doubling copies of the random prefix: one LZ match each, so compressors keep ~literalBytes
+        for (size_t pos = literalBytes; pos < BLOCK; ) {
+            size_t length = min(pos, BLOCK - pos);
+            memcpy(out + pos, out, length);
+            pos += length;
+        }
+    }
+
+public:
+    // Every kernel produces the same bytes; `best` caps the choice, e.g. to compare them
+    enum Kernel { Scalar, SSE2, AVX2 };
+
+    explicit PatternGenerator(uint64_t seedValue, Kernel best = AVX2)
+        : seed(seedValue), blockFn(&PatternGenerator::blockScalar), isa("scalar") {
+        #ifdef TURBO_HAVE_SSE2
+        if (best >= SSE2) {
+            blockFn = &PatternGenerator::blockSSE2;
+            isa = "SSE2";
+        }
+        #endif
+        #ifdef TURBO_HAVE_AVX2
+        if (best >= AVX2 && __builtin_cpu_supports("avx2")) {
+            blockFn = &PatternGenerator::blockAVX2;
+            isa = "AVX2";
+        }
+        #endif
+    }
+
+    const char* isaName() const { return isa; }
+    uint64_t seedValue() const { return seed; }
+
+    // Same kernel and shaping, different content
+    PatternGenerator reseeded(uint64_t seedValue) const {
+        PatternGenerator copy(*this);
+        copy.seed = seedValue;
+        return copy;
+    }
+
+    // Targets for compressors and dedup engines; dedup groups span 64 MB so any sample shows the ratio
+    void shape(double compressRatio, double dedupRatio, size_t dedupBlock) {
+        literalBytes = compressRatio > 1 ? max<size_t>(16, static_cast<size_t>(BLOCK / compressRatio + 0.5)) : BLOCK;
+        chunkBlocks = max<size_t>(1, dedupBlock / BLOCK);
+        groupChunks = 0;
+        if (dedupRatio > 1) {
+            groupChunks = 16;
+            while (groupChunks * chunkBlocks * BLOCK < 64ULL * 1024 * 1024) groupChunks <<= 1;
+            uniqueChunks = max<uint64_t>(1, static_cast<uint64_t>(groupChunks / dedupRatio + 0.5));
+        }
+    }
+
+    bool shaped() const { return literalBytes < BLOCK || groupChunks > 0; }
+    long long groupBytes() const { return static_cast<long long>(max<uint64_t>(1, groupChunks) * chunkBlocks * BLOCK); }
+
+    // Fills dst with the file content for [offset, offset + length)
+    void fill(char* dst, size_t length, long long offset) const {
+        uint64_t blockIndex = static_cast<uint64_t>(offset) / BLOCK;
+        size_t skip = static_cast<size_t>(offset % BLOCK);
+        
+        while (length > 0) {
+            if (skip == 0 && length >= BLOCK) {
+                produceBlock(blockIndex, dst);
+                dst += BLOCK;
+                length -= BLOCK;
+            } else {
+                char partial[BLOCK];
+                produceBlock(blockIndex, partial);
+                size_t take = min(length, BLOCK - skip);
+                memcpy(dst, partial + skip, take);
+                dst += take;
+                length -= take;
+                skip = 0;
+            }
+            blockIndex++;
+        }
+    }
+};
+
+// CRC32C (Castagnoli) checksum, using the SSE4.2 crc32 instruction when the CPU has it
+class Crc32c {
+private:
+    static const uint32_t* table() {
+        static const vector<uint32_t> entries = [] {
+            vector<uint32_t> t(256);
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t crc = i;
+                for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0x82F63B78U & (0U - (crc & 1U)));
+                t[i] = crc;
+            }
+            return t;
+        }();
+        return entries.data();
+    }
+
+    static uint32_t updateScalar(uint32_t crc, const char* data, size_t length) {
+        const uint32_t* t = table();
+        for (size_t i = 0; i < length; i++) {
+            crc = t[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (crc >> 8);
+        }
+        return crc;
+    }
+
+#if defined(TURBO_HAVE_AVX2) && defined(__x86_64__)
+    __attribute__((target("sse4.2")))
+    static uint32_t updateHardware(uint32_t crc, const char* data, size_t length) {
+        uint64_t c = crc;
+        while (length >= 8) {
+            uint64_t word;
+            memcpy(&word, data, sizeof(word));
+            c = _mm_crc32_u64(c, word);
+            data += 8;
+            length -= 8;
+        }
+        uint32_t c32 = static_cast<uint32_t>(c);
+        while (length > 0) {
+            c32 = _mm_crc32_u8(c32, static_cast<unsigned char>(*data++));
+            length--;
+        }
+        return c32;
+    }
+#endif
+
+public:
+    static uint32_t compute(const char* data, size_t length) {
+        #if defined(TURBO_HAVE_AVX2) && defined(__x86_64__)
+        static const bool hardware = __builtin_cpu_supports("sse4.2");
+        if (hardware) return ~updateHardware(0xFFFFFFFFU, data, length);
+        #endif
+        return ~updateScalar(0xFFFFFFFFU, data, length);
+    }
+};
+
+// Compressed-size estimate from a greedy LZ77 parse priced like LZ4, close to lz4 or zstd-fast
+class CompressEstimator {
+public:
+    static size_t compressedSize(const char* data, size_t length) {
+        const size_t MIN_MATCH = 4;
+        uint32_t table[4096];
+        memset(table, 0, sizeof(table));
+        
+        size_t cost = 0;
+        size_t pos = 0;
+        while (pos + MIN_MATCH <= length) {
+            uint32_t word;
+            memcpy(&word, data + pos, sizeof(word));
+            uint32_t slot = (word * 2654435761U) >> 20;
+            size_t candidate = table[slot];
+            table[slot] = static_cast<uint32_t>(pos + 1);
+            
+            if (candidate > 0 && pos - (candidate - 1) <= 65535 && memcmp(data + candidate - 1, data + pos, MIN_MATCH) == 0) {
+                size_t from = candidate - 1;
+                size_t match = MIN_MATCH;
+                while (pos + match < length && data[from + match] == data[pos + match]) match++;
+                cost += 3;
+                pos += match;
+            } else {
+                cost++;
+                pos++;
+            }
+        }
+        return cost + (length - pos);
+    }
+};
+
+// Write Backends
+enum class WriteBackend {
+    Stream,     // Blocking ofstream writes, one per thread
+    IoUring,    // Linux io_uring with many writes in flight per submitter
+    Mmap        // Generate straight into a shared file mapping, no write() copy
+};
+
+// When the mmap engine pushes dirty pages out
+enum class MsyncPolicy {
+    None,   // Leave it to kernel writeback (and the final flush)
+    Async,  // msync(MS_ASYNC) after each unit to start writeback early
+    Sync    // msync(MS_SYNC) after each unit; a unit is durable before the next is claimed
+};
+
+// Durability Policies
+enum class SyncMode {
+    None,       // Stop at the page cache; nothing forces data to stable storage
+    End,        // One fdatasync after the last write
+    Periodic,   // fdatasync every --sync-every MB written, plus the final one
+    Rolling     // sync_file_range: start writeback per block, wait on the previous block
+};
+
+// Access hint applied to each mapping
+enum class MadvisePolicy {
+    Normal,
+    Sequential,     // MADV_SEQUENTIAL: aggressive readahead-free streaming
+    HugePage        // MADV_HUGEPAGE where the filesystem supports large folios
+};
+
+// Output Formats
+enum class OutputFormat {
+    Text,   // Interactive ANSI dashboard
+    Json,   // One JSON object per line
+    Csv     // Header + row per record type
+};
+
+// Pre-allocation Strategies
+enum class PreallocMode {
+    None,           // Create the file empty; workers extend it as they write
+    Fallocate,      // Linux fallocate(): reserve extents without touching data
+    PosixFallocate, // posix_fallocate(): portable, may emulate by writing zeroes
+    ZeroRange       // fallocate(FALLOC_FL_ZERO_RANGE): allocate and mark as zeroed
+};
+
+// Workload Offset Distributions
+enum class OffsetDistribution {
+    Sequential, // Each worker walks its own slice of the file, wrapping at the end
+    Random,     // Uniform over every block
+    Zipf        // Skewed towards a hot set, as fio's random_distribution=zipf:theta
+};
+
+// Picks the block for each workload operation, one picker per worker
+class OffsetPicker {
+public:
+    // Read-only once built; like fio, the zeta sum stops at 10M ranks
+    struct Zipf {
+        double theta = 1.2;
+        double zetan = 0;
+        double zeta2 = 0;
+        long long blocks = 0;
+
+        void init(long long count, double skew) {
+            theta = skew;
+            blocks = max(1LL, count);
+            zeta2 = 1.0 + pow(0.5, theta);
+            zetan = 0;
+            long long terms = min(blocks, 10000000LL);
+            for (long long i = 1; i <= terms; i++) zetan += pow(static_cast<double>(i), -theta);
+        }
+    };
+
+private:
+    OffsetDistribution mode;
+    long long blocks;
+    long long first;
+    long long span;
+    long long cursor = 0;
+    uint64_t state;
+    const Zipf* zipf;
+
+    // splitmix64: independent stream per worker from one seed
+    uint64_t nextRandom() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Gray et al., "Quickly Generating Billion-Record Synthetic Databases"; rank 0 is hottest
+    long long zipfRank() {
+        double alpha = 1.0 / (1.0 - zipf->theta);
+        double eta = (1.0 - pow(2.0 / zipf->blocks, 1.0 - zipf->theta)) / (1.0 - zipf->zeta2 / zipf->zetan);
+        double u = uniform();
+        double z = u * zipf->zetan;
+        if (z < 1.0) return 0;
+        if (z < zipf->zeta2) return 1;
+        long long rank = static_cast<long long>(zipf->blocks * pow(eta * u - eta + 1.0, alpha));
+        return min(max(rank, 0LL), zipf->blocks - 1);
+    }
+
+public:
+    OffsetPicker(OffsetDistribution distribution, long long blockCount, int worker, int workers, uint64_t seed, const Zipf* table)
+        : mode(distribution), blocks(max(1LL, blockCount)), state(seed ^ (0xD1B54A32D192ED03ULL * (worker + 1))), zipf(table) {
+        first = blocks * worker / workers;
+        span = max(1LL, blocks * (worker + 1) / workers - first);
+    }
+
+    double uniform() {
+        return static_cast<double>(nextRandom() >> 11) / 9007199254740992.0;
+    }
+
+    long long next() {
+        switch (mode) {
+            case OffsetDistribution::Sequential: {
+                long long block = first + cursor;
+                cursor = (cursor + 1) % span;
+                return block;
+            }
+            case OffsetDistribution::Zipf: {
+                // Scatter ranks so the hot set is spread over the file instead of its first blocks
+                uint64_t h = static_cast<uint64_t>(zipfRank()) * 0x9E3779B97F4A7C15ULL;
+                return static_cast<long long>((h ^ (h >> 29)) % static_cast<uint64_t>(blocks));
+            }
+            default:
+                return static_cast<long long>(nextRandom() % static_cast<uint64_t>(blocks));
+        }
+    }
+};
+
+class TurboFileCreator;
+
+// Run View
+// Hooks for a live text display, called on the run's thread; quiet and JSON/CSV runs never call them
+class RunView {
+public:
+    virtual ~RunView() {}
+    
+    virtual void configured(const TurboFileCreator&) {}                         // A write run is set up
+    virtual void workloadConfigured(const TurboFileCreator&, double) {}         // Stop after this many seconds, 0 = op budget only
+    virtual void verifyConfigured(const TurboFileCreator&) {}                   // Standalone readback of an existing file
+    virtual void initializing(const TurboFileCreator&) {}                       // Checks passed, setting up the target
+    virtual void running(const TurboFileCreator&) {}                            // Workers launched, progress follows
+    virtual void verifying(const TurboFileCreator&) {}
+    virtual void progress(const TurboFileCreator&, long long, long long, double) {}        // Bytes done, total (0 = open), seconds
+    virtual void workloadProgress(const TurboFileCreator&, long long, long long, double, double) {}  // Reads, writes, seconds, limit
+    virtual void verifyProgress(const TurboFileCreator&, long long, long long, double) {}  // Bytes checked, to check, seconds
+    virtual void adapted(const TurboFileCreator&, const ConcurrencyController::Decision&) {}
+    virtual void stopped(const TurboFileCreator&) {}                            // The workers are done
+    virtual void warning(const TurboFileCreator&, const string&) {}
+    virtual void error(const TurboFileCreator&, const string&) {}
+    virtual void finished(const TurboFileCreator&, double) {}                   // Write run summary
+    virtual void workloadFinished(const TurboFileCreator&, double) {}
+    virtual void verified(const TurboFileCreator&, bool, long long, double) {}  // Passed, size on disk, seconds
+};
+
+struct CreatorOptions {
+    WriteBackend backend = WriteBackend::Stream;
+    int queueDepth = 32;
+    int submitters = 1;
+    bool directIO = false;
+    PreallocMode prealloc = PreallocMode::Fallocate;
+    bool allocateOnly = false;
+    SyncMode sync = SyncMode::End;
+    int syncEveryMB = 256;          // Periodic sync interval
+    vector<int> cpus;               // Writer i is pinned to cpus[i % size]; empty leaves scheduling alone
+    bool numaLocal = false;         // Allocate each writer's buffers on its own NUMA node
+    int ioprioClass = 0;            // 0 = inherit, 1 = realtime, 2 = best-effort, 3 = idle
+    int ioprioLevel = 4;            // 0 (highest) .. 7 within the realtime/best-effort class
+    int niceness = 0;               // Added to each writer's nice value; 0 leaves it unchanged
+    long long cloneSeed = 0;        // Write this much, then replicate it over the rest of the file
+    double compressRatio = 1;       // Random data: target compression ratio (1 = incompressible)
+    double dedupRatio = 1;          // Random data: target dedup ratio (1 = every chunk unique)
+    long long dedupBlock = 4096;    // Dedup chunk size; match the appliance's or the filesystem's record size
+    vector<string> stripeTargets;   // Paths after the file name; the size is striped RAID-0 style over all of them
+    long long stripeUnit = 1024 * 1024;     // Bytes on one target before the stripe moves to the next
+    int stripeIndex = 0;            // Set on each member of a stripe set: its position and the set width
+    int stripeCount = 1;
+    int readPercent = 50;           // Workload: share of operations that are reads
+    long long blockSize = 4096;     // Workload: bytes per operation, independent of the buffer size
+    OffsetDistribution distribution = OffsetDistribution::Random;
+    double zipfTheta = 1.2;
+    double duration = 0;            // Workload: stop after this many seconds (default 10 without --ops)
+    long long opLimit = 0;          // Workload: stop after this many operations in total
+    bool stream = false;            // Target is stdout ("-") or a FIFO rather than a regular file
+    bool unbounded = false;         // Stream until the reader goes away or Ctrl-C; needs stream
+    bool streamCopy = false;        // Use write() even where vmsplice could map the buffers
+    string checkpointPath;          // Non-empty enables checkpointing of completed units
+    bool resume = false;            // Continue from checkpointPath instead of starting over
+    int resumeVerifyUnits = 0;      // Completed units to re-read before resuming
+    int pipelineDepth = 2;          // Buffers per writer for overlapped generate/write; < 2 disables
+    MsyncPolicy msync = MsyncPolicy::None;
+    MadvisePolicy madvise = MadvisePolicy::Sequential;
+    uint64_t seed = 0x5EEDF11EC0DEULL;
+    bool verifyAfterWrite = false;
+    int chunkMB = 0;    // Scheduler work unit; 0 picks one from file size and writer count
+    bool adaptive = false;          // Vary the active writers at runtime; the thread count is the ceiling
+    OutputFormat format = OutputFormat::Text;
+    double progressInterval = 0;    // Seconds between headless progress records; 0 disables them
+    string metricsFile;             // Prometheus text file, rewritten every metricsInterval
+    string metricsListen;           // "[HOST:]PORT" or "unix:PATH" to serve the same page over HTTP
+    double metricsInterval = 5;
+    double rateLimit = 0;           // Target bytes/s shared by all writers; 0 is unthrottled
+    long long rateBurst = 0;        // Token bucket depth in bytes; 0 picks 100 ms of the target
+    double rateRamp = 0;            // Seconds to ramp linearly from 0 up to the target
+    vector<RateStep> rateProfile;   // Step schedule overriding rateLimit when non-empty
+    bool quiet = false;             // No output at all; used for bench sweeps
+    RunView* view = nullptr;        // Text display; not owned, and ignored when quiet or structured
+};
+
+#ifdef TURBO_HAVE_IO_URING
+// Minimal io_uring ring driven through raw syscalls (no liburing dependency)
+class UringQueue {
+private:
+    int ringFd = -1;
+    unsigned entries = 0;
+    unsigned pendingSubmit = 0;
+
+    void* sqRing = nullptr;
+    void* cqRing = nullptr;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqesSize = 0;
+
+    unsigned* sqHead = nullptr;
+    unsigned* sqTail = nullptr;
+    unsigned* sqMask = nullptr;
+    unsigned* sqArray = nullptr;
+    unsigned* cqHead = nullptr;
+    unsigned* cqTail = nullptr;
+    unsigned* cqMask = nullptr;
+    io_uring_cqe* cqes = nullptr;
+
+public:
+    UringQueue() = default;
+    UringQueue(const UringQueue&) = delete;
+    UringQueue& operator=(const UringQueue&) = delete;
+
+    ~UringQueue() {
+        if (sqes) munmap(sqes, sqesSize);
+        if (cqRing && cqRing != sqRing) munmap(cqRing, cqRingSize);
+        if (sqRing) munmap(sqRing, sqRingSize);
+        if (ringFd >= 0) close(ringFd);
+    }
+
+    // A ring alone is not enough: plain IORING_OP_WRITE only arrived in 5.6, so ask the kernel
+    static bool isSupported() {
+        UringQueue probe;
+        return probe.init(1) && probe.supports(IORING_OP_WRITE);
+    }
+
+    bool supports(unsigned opcode) const {
+        const unsigned maxOps = 256;
+        vector<char> storage(sizeof(io_uring_probe) + maxOps * sizeof(io_uring_probe_op), 0);
+        io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+        if (syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_PROBE, probe, maxOps) != 0) return false;
+        return opcode <= probe->last_op && opcode < probe->ops_len &&
+               (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) != 0;
+    }
+
+    bool init(unsigned depth) {
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+
+        ringFd = static_cast<int>(syscall(__NR_io_uring_setup, depth, &params));
+        if (ringFd < 0) return false;
+        entries = params.sq_entries;
+
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMmap) sqRingSize = cqRingSize = max(sqRingSize, cqRingSize);
+
+        sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        if (sqRing == MAP_FAILED) { sqRing = nullptr; return false; }
+
+        if (singleMmap) {
+            cqRing = sqRing;
+        } else {
+            cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+            if (cqRing == MAP_FAILED) { cqRing = nullptr; return false; }
+        }
+
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqeMem = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+        if (sqeMem == MAP_FAILED) return false;
+        sqes = static_cast<io_uring_sqe*>(sqeMem);
+
+        char* sq = static_cast<char*>(sqRing);
+        char* cq = static_cast<char*>(cqRing);
+        sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    bool registerBuffers(const vector<iovec>& buffers) {
+        return syscall(__NR_io_uring_register, ringFd, IORING_REGISTER_BUFFERS,
+                       buffers.data(), static_cast<unsigned>(buffers.size())) == 0;
+    }
+
+    // Returns nullptr when the submission ring is full
+    io_uring_sqe* nextSqe() {
+        unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        unsigned tail = *sqTail;
+        if (tail - head >= entries) return nullptr;
+
+        unsigned idx = tail & *sqMask;
+        io_uring_sqe* sqe = &sqes[idx];
+        memset(sqe, 0, sizeof(*sqe));
+        sqArray[idx] = idx;
+        __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+        pendingSubmit++;
+        return sqe;
+    }
+
+    // Submits queued entries and optionally blocks until waitNr completions arrive
+    bool submitAndWait(unsigned waitNr) {
+        while (true) {
+            unsigned flags = waitNr > 0 ? IORING_ENTER_GETEVENTS : 0;
+            long ret = syscall(__NR_io_uring_enter, ringFd, pendingSubmit, waitNr, flags, nullptr, 0);
+            if (ret >= 0) {
+                pendingSubmit -= min(pendingSubmit, static_cast<unsigned>(ret));
+                return true;
+            }
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY) return false;
+        }
+    }
+
+    // Drains every available completion, advancing the CQ head once per batch
+    template <typename Handler>
+    unsigned reap(Handler&& onComplete) {
+        unsigned head = *cqHead;
+        unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        unsigned count = 0;
+
+        while (head != tail) {
+            const io_uring_cqe& cqe = cqes[head & *cqMask];
+            onComplete(cqe.user_data, cqe.res);
+            head++;
+            count++;
+        }
+
+        if (count > 0) __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+        return count;
+    }
+};
+#endif
+
+// Batch Manifest
+// Explicit entries, or a generator spec deriving each path and size from the file index
+struct BatchPlan {
+    struct SizeChoice {
+        long long bytes;
+        double cumulativeWeight;
+    };
+
+    string root = ".";
+    vector<pair<string, long long>> manifest;
+    long long generatedCount = 0;
+    vector<SizeChoice> sizeMix;     // Weighted fixed sizes
+    long long rangeMin = 4096;      // Log-uniform range, used when sizeMix is empty
+    long long rangeMax = 4096;
+    int fanoutWidth = 0;
+    int fanoutDepth = 0;
+    uint64_t seed = 0;
+
+    long long count() const {
+        return manifest.empty() ? generatedCount : static_cast<long long>(manifest.size());
+    }
+
+    static uint64_t mix(uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    long long sizeOf(long long index) const {
+        if (!manifest.empty()) return manifest[index].second;
+        
+        double u = (mix(seed ^ (static_cast<uint64_t>(index) * 0x9E3779B97F4A7C15ULL)) >> 11) * (1.0 / 9007199254740992.0);
+        if (!sizeMix.empty()) {
+            double pick = u * sizeMix.back().cumulativeWeight;
+            for (const auto& choice : sizeMix) {
+                if (pick < choice.cumulativeWeight) return choice.bytes;
+            }
+            return sizeMix.back().bytes;
+        }
+        if (rangeMax <= rangeMin) return rangeMin;
+        
+        double lo = log(static_cast<double>(max(1LL, rangeMin)));
+        double hi = log(static_cast<double>(rangeMax));
+        return min(rangeMax, max(rangeMin, static_cast<long long>(exp(lo + u * (hi - lo)))));
+    }
+
+    // Generated files are spread round-robin over fanoutWidth^fanoutDepth leaf directories
+    string directoryOf(long long index) const {
+        string dir;
+        int digits = static_cast<int>(to_string(max(1, fanoutWidth - 1)).size());
+        long long slot = index;
+        for (int level = 0; level < fanoutDepth; level++) {
+            string name = to_string(slot % fanoutWidth);
+            dir += (dir.empty() ? "d" : "/d") + string(digits - name.size(), '0') + name;
+            slot /= fanoutWidth;
+        }
+        return dir;
+    }
+
+    string pathOf(long long index) const {
+        if (!manifest.empty()) {
+            const string& path = manifest[index].first;
+            return path[0] == '/' ? path : root + "/" + path;
+        }
+        
+        string name = to_string(index);
+        name = "file_" + string(name.size() < 8 ? 8 - name.size() : 0, '0') + name + ".bin";
+        string dir = directoryOf(index);
+        return root + "/" + (dir.empty() ? "" : dir + "/") + name;
+    }
+
+    long long totalBytes() const {
+        long long total = 0;
+        for (long long i = 0; i < count(); i++) total += sizeOf(i);
+        return total;
+    }
+
+    // Every directory the plan needs, parents before children
+    vector<string> directories() const {
+        vector<string> leaves;
+        if (!manifest.empty()) {
+            for (const auto& entry : manifest) {
+                string path = entry.first[0] == '/' ? entry.first : root + "/" + entry.first;
+                size_t slash = path.rfind('/');
+                if (slash != string::npos && slash > 0) leaves.push_back(path.substr(0, slash));
+            }
+        } else {
+            long long leafCount = 1;
+            for (int level = 0; level < fanoutDepth; level++) leafCount *= fanoutWidth;
+            for (long long i = 0; i < min(leafCount, max(1LL, generatedCount)); i++) {
+                string dir = directoryOf(i);
+                leaves.push_back(dir.empty() ? root : root + "/" + dir);
+            }
+        }
+        
+        vector<string> all;
+        for (const string& leaf : leaves) {
+            for (size_t slash = leaf.find('/', 1); slash != string::npos; slash = leaf.find('/', slash + 1)) {
+                all.push_back(leaf.substr(0, slash));
+            }
+            all.push_back(leaf);
+        }
+        sort(all.begin(), all.end());
+        all.erase(unique(all.begin(), all.end()), all.end());
+        return all;
+    }
+};
+
+// Turbocharged File Creator
+class TurboFileCreator {
+    // The command line's terminal display reads the run's counters directly
+    friend class Dashboard;
+    
+private:
+    string fileName;
+    long long fileSize;
+    atomic<long long> progressTotal{0};  // fileSize as progress() may read it from another thread
+    int numThreads;
+    int bufferSizeMB;
+    
+    atomic<long long> bytesWritten{0};
+    atomic<bool> errorFlag{false};
+    atomic<bool> cancelRequested{false};
+    string failure;     // First error reported, kept for embedding callers that run quiet
+    string ioFailure;   // First errno a worker hit, used as the reason when the run fails
+    mutex ioFailureMutex;
+    atomic<int> activeWorkers{0};
+    atomic<int> writerLimit{INT_MAX};   // Writers with a lower ID may claim work; set by the adaptive controller
+    ConcurrencyController controller;
+    double flushTime = 0;
+    atomic<long long> syncCounter{0};
+    atomic<int> placementFailures{0};
+    
+    // Clone mode: the seed region is replicated with the cheapest mechanism that still works
+    enum class CloneMethod { Reflink, Copy, Rewrite };
+    atomic<int> cloneMethod{static_cast<int>(CloneMethod::Reflink)};
+    ChunkScheduler cloneScheduler;
+    atomic<int> seedWriters{0};
+    atomic<long long> reflinkBytes{0};
+    atomic<long long> copiedBytes{0};
+    atomic<long long> rewrittenBytes{0};
+    
+    // Workload mode
+    OffsetPicker::Zipf zipfTable;
+    atomic<long long> opsIssued{0};
+    atomic<bool> workloadStop{false};
+    
+    // Striped output: one quiet creator per target, each running its own worker group
+    struct StripeMember {
+        unique_ptr<TurboFileCreator> creator;
+        thread runner;
+        atomic<bool> finished{false};
+        bool succeeded = false;
+        bool verified = false;
+        bool cancelled = false;     // Stopped because another member failed
+        double finishedAt = 0;
+    };
+    vector<unique_ptr<StripeMember>> stripes;
+    
+    StreamSink sink;
+    vector<int> droppedCpus;
+    
+    // Metrics export: the monitor renders each page and hands it to the server
+    MetricsServer metricsServer;
+    bool metricsStarted = false;
+    bool metricsFileFailed = false;
+    double nextMetrics = 0;
+    long long metricsBytes = 0;
+    double metricsElapsed = 0;
+    Checkpoint checkpoint;
+    thread checkpointSaver;
+    atomic<bool> checkpointStop{false};
+    vector<bool> skipUnits;
+    atomic<long long> resumedBytes{0};
+    long long resumeChecked = 0;
+    long long resumeRepaired = 0;
+    atomic<long long> bytesVerified{0};
+    vector<string> csvHeadersShown;
+    ChunkScheduler scheduler;
+    unique_ptr<WorkerStats[]> workerStats;
+    int workerStatsCount = 0;
+    atomic<long long> firstMismatch{LLONG_MAX};
+    double preallocTime = 0;
+    string preallocMethod;
+    RateLimiter limiter;
+    size_t pacedSlice = SIZE_MAX;   // Largest single write while a rate limit is on: one burst
+    long long windowBytes = 0;
+    double windowStart = 0;
+    double achievedRate = 0;
+    double writeTime = 0;
+    const BatchPlan* batch = nullptr;
+    bool reductionEstimated = false;
+    double compressEstimate = 0;
+    double dedupEstimate = 0;
+    unique_ptr<AlignedBuffer> zeroBuffer;
+    double mkdirTime = 0;
+    long long directoriesCreated = 0;
+    
+    AdvancedStats stats;
+    bool useRandomData;
+    bool turboMode;
+    CreatorOptions options;
+    PatternGenerator generator;
+    
+    int writerCount() const {
+        if (options.stream) return 1;
+        return stripeWidth() * (options.backend == WriteBackend::IoUring ? options.submitters : stripeThreads());
+    }
+
+    int stripeWidth() const {
+        return 1 + static_cast<int>(options.stripeTargets.size());
+    }
+
+    // The thread count is split evenly between the targets of a stripe set
+    int stripeThreads() const {
+        return max(1, numThreads / stripeWidth());
+    }
+
+    // Bytes target `index` holds when `total` is laid out in `unit` pieces round-robin over `width` targets
+    static long long stripeShare(long long total, long long unit, int width, int index) {
+        long long pieces = total / unit;
+        long long share = (pieces / width + (index < pieces % width ? 1 : 0)) * unit;
+        if (index == pieces % width) share += total % unit;
+        return share;
+    }
+
+    // Scheduler unit: several per worker to even out stragglers, a multiple of 4 KB for direct I/O
+    long long chunkUnit(long long total, int workers) const {
+        const long long MB = 1024LL * 1024;
+        long long unit = options.chunkMB > 0 ? options.chunkMB * MB
+                                             : min(256 * MB, max(MB, total / (static_cast<long long>(workers) * 8)));
+        return max(static_cast<long long>(AlignedBuffer::ALIGNMENT), AlignedBuffer::alignDown(unit));
+    }
+
+    string targetName() const {
+        return options.stream && fileName == "-" ? "stdout" : fileName;
+    }
+
+    string backendName() const {
+        if (options.stream) {
+            return string("stream sink (") + sink.pathName() + ")";
+        }
+        if (options.backend == WriteBackend::IoUring) {
+            return "io_uring (QD " + to_string(options.queueDepth) + " x " + to_string(options.submitters) + " submitter" + (options.submitters > 1 ? "s" : "") + ")";
+        }
+        if (options.backend == WriteBackend::Mmap) {
+            static const char* msyncNames[] = {"writeback", "msync async", "msync sync"};
+            static const char* adviceNames[] = {"normal", "sequential", "hugepage"};
+            return string("mmap (") + msyncNames[static_cast<int>(options.msync)] + ", " + adviceNames[static_cast<int>(options.madvise)] + ")";
+        }
+        return "ofstream (blocking)";
+    }
+
+    static string preallocName(PreallocMode mode) {
+        switch (mode) {
+            case PreallocMode::None: return "none";
+            case PreallocMode::Fallocate: return "fallocate";
+            case PreallocMode::PosixFallocate: return "posix_fallocate";
+            case PreallocMode::ZeroRange: return "zero-range";
+        }
+        return "unknown";
+    }
+
+    string formatBytes(long long bytes) const {
+        const char* units[] = {"B", "KB", "MB", "GB", "TB", "PB"};
+        int idx = 0;
+        double size = static_cast<double>(bytes);
+        
+        while (size >= 1024.0 && idx < 5) {
+            size /= 1024.0;
+            idx++;
+        }
+        
+        stringstream ss;
+        ss << fixed << setprecision(2) << size << " " << units[idx];
+        return ss.str();
+    }
+
+    string formatDuration(double seconds) const {
+        if (seconds < 0.001) return to_string(static_cast<int>(seconds * 1000000)) + " μs";
+        if (seconds < 1.0) return to_string(static_cast<int>(seconds * 1000)) + " ms";
+        if (seconds < 60.0) {
+            stringstream ss;
+            ss << fixed << setprecision(3) << seconds << " sec";
+            return ss.str();
+        }
+        if (seconds < 3600.0) {
+            return to_string(static_cast<int>(seconds / 60)) + "m " + 
+                   to_string(static_cast<int>(seconds) % 60) + "s";
+        }
+        return to_string(static_cast<int>(seconds / 3600)) + "h " + 
+               to_string(static_cast<int>(seconds / 60) % 60) + "m";
+    }
+
+    // Monitor tick: speed history, shaped-rate window and metrics export, then the display
+    void trackProgress(long long current, long long total, double elapsed) {
+        stats.recordSpeed(elapsed > 0 ? (current - resumedBytes) / elapsed : 0);
+        
+        // Shaped runs are judged on the recent rate, not the cumulative average
+        if (elapsed - windowStart >= 1.0) {
+            achievedRate = (current - windowBytes) / (elapsed - windowStart);
+            windowBytes = current;
+            windowStart = elapsed;
+        }
+        metricsBytes = current;
+        metricsElapsed = elapsed;
+        if (metricsStarted && elapsed >= nextMetrics) {
+            publishMetrics(true);
+            nextMetrics = elapsed + options.metricsInterval;
+        }
+        if (view()) view()->progress(*this, current, total, elapsed);
+    }
+
+    // Stripe member with the lowest throughput so far; a finished member is judged on its own run time
+    int slowestStripe(double elapsed, double& rate) const {
+        int slowest = -1;
+        for (size_t i = 0; i < stripes.size(); i++) {
+            const StripeMember& member = *stripes[i];
+            if (member.creator->fileSize == 0) continue;
+            double span = member.finished ? member.finishedAt : elapsed;
+            double memberRate = span > 0 ? member.creator->bytesWritten.load() / span : 0;
+            if (slowest < 0 || memberRate < rate) {
+                slowest = static_cast<int>(i);
+                rate = memberRate;
+            }
+        }
+        return slowest;
+    }
+
+    // Every controller decision goes to the log as it happens, so a run can be audited afterwards
+    void logDecision(const ConcurrencyController::Decision& decision) {
+        if (headless()) {
+            emitRecord(StructuredRecord("adapt").addNumber("elapsed_sec", decision.atSeconds)
+                                                .addInt("from_writers", decision.from)
+                                                .addInt("to_writers", decision.to)
+                                                .addNumber("rate_bps", decision.rate, 0)
+                                                .addText("reason", decision.reason));
+            return;
+        }
+        if (view()) view()->adapted(*this, decision);
+    }
+
+    // Per-worker histograms are only merged at report time, after the writers are done
+    void mergeLatency(LatencyHistogram& merged) const {
+        for (int i = 0; i < workerStatsCount; i++) {
+            merged.merge(workerStats[i].writeLatency);
+        }
+    }
+
+    double loadBalance(long long& minBytes, long long& maxBytes) const {
+        minBytes = workerStatsCount > 0 ? LLONG_MAX : 0;
+        maxBytes = 0;
+        for (int i = 0; i < workerStatsCount; i++) {
+            minBytes = min(minBytes, workerStats[i].bytes.load());
+            maxBytes = max(maxBytes, workerStats[i].bytes.load());
+        }
+        return maxBytes > 0 ? static_cast<double>(minBytes) / maxBytes * 100 : 100;
+    }
+
+    // Peak resident set size of the process, 0 where it cannot be queried
+    static long long peakResidentBytes() {
+        #ifdef _WIN32
+        return 0;
+        #else
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+        #ifdef __APPLE__
+        return usage.ru_maxrss;
+        #else
+        return usage.ru_maxrss * 1024LL;
+        #endif
+        #endif
+    }
+
+    static string bufferPageKind() {
+        if (AlignedBuffer::usage().hugeTlb > 0) return "HugeTLB";
+        if (AlignedBuffer::usage().thp > 0) return "THP hint";
+        return "4 KB pages";
+    }
+
+    void emitStripeRecords() {
+        for (size_t i = 0; i < stripes.size(); i++) {
+            const TurboFileCreator& member = *stripes[i]->creator;
+            StructuredRecord record("target");
+            record.addInt("index", static_cast<long long>(i))
+                  .addText("file", member.fileName)
+                  .addInt("size_bytes", member.fileSize)
+                  .addNumber("elapsed_sec", member.writeTime, 6)
+                  .addNumber("flush_sec", member.flushTime, 6)
+                  .addNumber("device_bps", member.committedSpeed(member.writeTime), 0)
+                  .addInt("workers", member.writerCount())
+                  .addText("engine", member.backendName())
+                  .addBool("succeeded", stripes[i]->succeeded);
+            if (options.verifyAfterWrite) record.addBool("verified", stripes[i]->verified);
+            emitRecord(record);
+        }
+    }
+
+    // Folds the members' counters into this creator so the usual summary covers the whole set
+    void absorbStripes() {
+        int total = 0;
+        for (auto& stripe : stripes) total += stripe->creator->workerStatsCount;
+        workerStatsCount = total;
+        workerStats.reset(new WorkerStats[total]);
+        
+        int slot = 0;
+        for (auto& stripe : stripes) {
+            TurboFileCreator& member = *stripe->creator;
+            for (int i = 0; i < member.workerStatsCount; i++, slot++) {
+                WorkerStats& from = member.workerStats[i];
+                WorkerStats& into = workerStats[slot];
+                into.bytes = from.bytes.load();
+                into.units = from.units.load();
+                into.writeLatency.merge(from.writeLatency);
+                into.generateNanos = from.generateNanos.load();
+                into.generateStallNanos = from.generateStallNanos.load();
+                into.writeStallNanos = from.writeStallNanos.load();
+                into.syncNanos = from.syncNanos.load();
+            }
+            stats.operationCount += member.stats.operationCount.load();
+            preallocTime = max(preallocTime, member.preallocTime);
+        }
+        
+        TurboFileCreator& first = *stripes.front()->creator;
+        preallocMethod = first.preallocMethod;
+        options.backend = first.options.backend;
+        options.directIO = first.options.directIO;
+        scheduler.reset(fileSize, first.scheduler.unit());
+    }
+
+    // Busy share of the generate and write stages; only the stream engine separates the two
+    bool stageUtilization(double totalTime, double& generatePct, double& writePct, string& bound) const {
+        if (!useRandomData || options.backend != WriteBackend::Stream || workerStatsCount == 0 || totalTime <= 0) return false;
+        
+        double generateNs = 0, writeNs = 0, generateStallNs = 0, writeStallNs = 0;
+        for (int i = 0; i < workerStatsCount; i++) {
+            generateNs += workerStats[i].generateNanos.load();
+            writeNs += workerStats[i].writeLatency.sum();
+            generateStallNs += workerStats[i].generateStallNanos.load();
+            writeStallNs += workerStats[i].writeStallNanos.load();
+        }
+        double wall = totalTime * 1e9 * workerStatsCount;
+        generatePct = generateNs / wall * 100;
+        writePct = writeNs / wall * 100;
+        
+        // Pipelined: whichever stage waits more is the one being outrun. Sequential: the bigger share wins.
+        bool cpuBound = pipelined() ? writeStallNs > generateStallNs : generateNs > writeNs;
+        bound = cpuBound ? "CPU-bound" : "I/O-bound";
+        return true;
+    }
+
+    void updateEfficiency() {
+        stats.efficiency = stats.avgSpeed > 0 ? (stats.avgSpeed / stats.peakSpeed.load()) * 100 : 0;
+    }
+
+    bool headless() const {
+        return options.quiet || options.format != OutputFormat::Text;
+    }
+
+    RunView* view() const {
+        return headless() ? nullptr : options.view;
+    }
+
+    void emitRecord(const StructuredRecord& record) {
+        if (options.quiet) return;
+        if (options.format == OutputFormat::Json) {
+            cout << record.json() << "\n";
+        } else {
+            if (find(csvHeadersShown.begin(), csvHeadersShown.end(), record.type()) == csvHeadersShown.end()) {
+                cout << record.csvHeader() << "\n";
+                csvHeadersShown.push_back(record.type());
+            }
+            cout << record.csvRow() << "\n";
+        }
+        cout << flush;
+    }
+
+    void reportError(const string& message) {
+        if (failure.empty()) failure = message;
+        if (headless()) {
+            emitRecord(StructuredRecord("error").addText("message", message));
+            return;
+        }
+        if (view()) view()->error(*this, message);
+    }
+
+    string failureReason(const string& fallback) {
+        if (cancelRequested) return "Cancelled";
+        lock_guard<mutex> lock(ioFailureMutex);
+        return ioFailure.empty() ? fallback : ioFailure;
+    }
+
+    // Workers record why they stopped; only the first cause is kept
+    void noteFailure(const string& what, int error) {
+        errorFlag = true;
+        lock_guard<mutex> lock(ioFailureMutex);
+        if (ioFailure.empty()) ioFailure = what + ": " + strerror(error);
+    }
+
+    void reportWarning(const string& message) {
+        if (headless()) {
+            emitRecord(StructuredRecord("warning").addText("message", message));
+            return;
+        }
+        if (view()) view()->warning(*this, message);
+    }
+
+    void emitProgressRecord(long long current, double elapsed) {
+        StructuredRecord record("progress");
+        record.addNumber("elapsed_sec", elapsed)
+              .addInt("bytes", current)
+              .addInt("total_bytes", fileSize)
+              .addNumber("percent", fileSize > 0 ? current * 100.0 / fileSize : 100.0, 2)
+              .addNumber("rate_bps", elapsed > 0 ? (current - resumedBytes) / elapsed : 0, 0)
+              .addNumber("avg_bps", stats.avgSpeed, 0)
+              .addInt("active_workers", activeWorkers.load());
+        if (limiter.enabled()) {
+            record.addNumber("target_bps", limiter.currentRate(), 0)
+                  .addNumber("achieved_bps", achievedRate, 0);
+        }
+        double slowestRate = 0;
+        int slowest = slowestStripe(elapsed, slowestRate);
+        if (slowest >= 0) {
+            record.addInt("slowest_target", slowest)
+                  .addNumber("slowest_bps", slowestRate, 0);
+        }
+        emitRecord(record);
+    }
+
+    // Prometheus text exposition, one `file` label per series so runs can share a collector directory
+    string renderMetrics(bool running) const {
+        string file;
+        for (char c : fileName) {
+            if (c == '\\' || c == '"') file += '\\';
+            file += c == '\n' ? ' ' : c;
+        }
+        string label = "file=\"" + file + "\"";
+        
+        ostringstream page;
+        auto describe = [&](const char* name, const char* type, const char* help) {
+            page << "# HELP file_creator_" << name << " " << help << "\n";
+            page << "# TYPE file_creator_" << name << " " << type << "\n";
+        };
+        auto sample = [&](const char* name, const string& extra, long long value) {
+            page << "file_creator_" << name << "{" << label << extra << "} " << value << "\n";
+        };
+        
+        double average = metricsElapsed > 0 ? (metricsBytes - resumedBytes) / metricsElapsed : 0;
+        describe("running", "gauge", "1 while the run is in progress.");
+        sample("running", "", running ? 1 : 0);
+        describe("bytes_written_total", "counter", "Bytes written, resumed bytes included.");
+        sample("bytes_written_total", "", metricsBytes);
+        describe("target_bytes", "gauge", "Bytes to write; 0 for an unbounded stream.");
+        sample("target_bytes", "", fileSize);
+        describe("elapsed_seconds", "gauge", "Seconds since the writers started.");
+        page << "file_creator_elapsed_seconds{" << label << "} " << fixed << setprecision(3) << metricsElapsed << "\n";
+        describe("current_rate_bytes_per_second", "gauge", "Write rate over the last second.");
+        sample("current_rate_bytes_per_second", "", static_cast<long long>(achievedRate));
+        describe("average_rate_bytes_per_second", "gauge", "Write rate since the start.");
+        sample("average_rate_bytes_per_second", "", static_cast<long long>(average));
+        describe("peak_rate_bytes_per_second", "gauge", "Highest average rate seen.");
+        sample("peak_rate_bytes_per_second", "", static_cast<long long>(stats.peakSpeed.load()));
+        describe("operations_total", "counter", "Write calls completed.");
+        sample("operations_total", "", stats.operationCount.load());
+        describe("active_workers", "gauge", "Writers currently running.");
+        sample("active_workers", "", activeWorkers.load());
+        if (options.adaptive) {
+            describe("writer_limit", "gauge", "Writers admitted by the adaptive controller.");
+            sample("writer_limit", "", min(writerLimit.load(), workerStatsCount));
+        }
+        
+        describe("worker_bytes_written_total", "counter", "Bytes written per writer thread.");
+        for (int i = 0; i < workerStatsCount; i++) {
+            sample("worker_bytes_written_total", ",thread=\"" + to_string(i) + "\"", workerStats[i].bytes.load());
+        }
+        describe("worker_units_total", "counter", "Work units completed per writer thread.");
+        for (int i = 0; i < workerStatsCount; i++) {
+            sample("worker_units_total", ",thread=\"" + to_string(i) + "\"", workerStats[i].units.load());
+        }
+        
+        vector<uint64_t> limits;
+        for (int shift = 10; shift <= 34; shift += 2) limits.push_back(1ULL << shift);
+        describe("write_latency_seconds", "histogram", "Write call latency per writer thread.");
+        page << defaultfloat << setprecision(12);
+        for (int i = 0; i < workerStatsCount; i++) {
+            const LatencyHistogram& latency = workerStats[i].writeLatency;
+            string thread = "thread=\"" + to_string(i) + "\"";
+            vector<uint64_t> below = latency.countsBelow(limits);
+            for (size_t b = 0; b < limits.size(); b++) {
+                page << "file_creator_write_latency_seconds_bucket{" << label << "," << thread << ",le=\""
+                     << limits[b] / 1e9 << "\"} " << below[b] << "\n";
+            }
+            page << "file_creator_write_latency_seconds_bucket{" << label << "," << thread << ",le=\"+Inf\"} " << latency.count() << "\n";
+            page << "file_creator_write_latency_seconds_sum{" << label << "," << thread << "} " << latency.sum() / 1e9 << "\n";
+            page << "file_creator_write_latency_seconds_count{" << label << "," << thread << "} " << latency.count() << "\n";
+        }
+        return page.str();
+    }
+
+    // Runs on the monitor thread
+    void publishMetrics(bool running) {
+        string page = renderMetrics(running);
+        if (!options.metricsFile.empty() && !metricsFileFailed && !MetricsServer::writeFile(options.metricsFile, page)) {
+            metricsFileFailed = true;
+            reportWarning("Cannot write metrics to '" + options.metricsFile + "', stopped exporting to it");
+        }
+        metricsServer.publish(move(page));
+    }
+
+    void startMetrics() {
+        if (metricsStarted || (options.metricsFile.empty() && options.metricsListen.empty())) return;
+        metricsStarted = true;
+        options.metricsInterval = max(0.1, options.metricsInterval);
+        publishMetrics(true);
+        string error;
+        if (!options.metricsListen.empty() && !metricsServer.listen(options.metricsListen, error)) reportWarning(error);
+    }
+
+    // Final page with running = 0, then the endpoint closes
+    void stopMetrics() {
+        if (!metricsStarted) return;
+        metricsStarted = false;
+        publishMetrics(false);
+        metricsServer.stop();
+    }
+
+    // Keeps the metrics export open for the length of one run
+    struct MetricsSession {
+        TurboFileCreator& owner;
+        explicit MetricsSession(TurboFileCreator& creator) : owner(creator) { owner.startMetrics(); }
+        ~MetricsSession() { owner.stopMetrics(); }
+    };
+
+    // End of a write run: the summary record, or the display's statistics
+    void reportSummary(double totalTime) {
+        updateEfficiency();
+        estimateReduction();
+        if (headless()) emitSummary(totalTime);
+        else if (view()) view()->finished(*this, totalTime);
+    }
+
+    void emitSummary(double totalTime) {
+        LatencyHistogram latency;
+        mergeLatency(latency);
+        long long minBytes, maxBytes;
+        double balance = loadBalance(minBytes, maxBytes);
+        
+        StructuredRecord record("summary");
+        record.addText("file", fileName)
+              .addInt("size_bytes", fileSize)
+              .addNumber("elapsed_sec", totalTime, 6)
+              .addNumber("final_bps", committedSpeed(totalTime), 0);
+        // Direct I/O has no cached phase to report
+        if (!options.directIO) record.addNumber("cached_bps", totalTime > 0 ? runBytes() / totalTime : 0, 0);
+        record.addNumber("avg_bps", stats.avgSpeed, 0)
+              .addNumber("peak_bps", stats.peakSpeed.load(), 0)
+              .addNumber("flush_sec", flushTime, 6)
+              .addText("sync_mode", syncName(options.sync))
+              .addNumber("sync_sec", inRunSyncNanos() / 1e9, 6)
+              .addNumber("efficiency_pct", stats.efficiency, 1)
+              .addInt("operations", stats.operationCount.load())
+              .addInt("workers", writerCount())
+              .addBool("adaptive", options.adaptive)
+              .addInt("adaptive_writers", options.adaptive ? controller.writers() : writerCount())
+              .addBool("adaptive_settled", options.adaptive && controller.settled())
+              .addInt("adaptive_decisions", static_cast<long long>(controller.decisions().size()))
+              .addText("engine", backendName())
+              .addBool("direct_io", options.directIO)
+              .addText("prealloc", preallocMethod)
+              .addNumber("prealloc_sec", preallocTime, 6)
+              .addBool("random", useRandomData)
+              .addInt("seed", static_cast<long long>(generator.seedValue()))
+              .addNumber("load_balance_pct", balance, 1)
+              .addInt("buffer_peak_bytes", AlignedBuffer::usage().peak.load())
+              .addText("buffer_pages", bufferPageKind())
+              .addInt("peak_rss_bytes", peakResidentBytes())
+              .addNumber("target_bps", limiter.enabled() ? limiter.meanRate(totalTime) : 0, 0)
+              .addInt("resumed_bytes", resumedBytes)
+              .addInt("clone_seed_bytes", options.cloneSeed)
+              .addText("clone_method", cloneMethodName())
+              .addInt("reflink_bytes", reflinkBytes.load())
+              .addInt("copy_range_bytes", copiedBytes.load())
+              .addInt("rewrite_bytes", rewrittenBytes.load())
+              .addNumber("compress_target", options.compressRatio, 2)
+              .addNumber("compress_est", compressEstimate, 2)
+              .addNumber("dedup_target", options.dedupRatio, 2)
+              .addNumber("dedup_est", dedupEstimate, 2)
+              .addInt("stripe_targets", stripeWidth())
+              .addInt("stripe_unit", options.stripeTargets.empty() ? 0 : options.stripeUnit)
+              .addBool("stream", options.stream)
+              .addBool("unbounded", options.unbounded)
+              .addText("cpus", CpuTopology::format(options.cpus))
+              .addBool("numa_local", options.numaLocal)
+              .addText("ioprio", ioprioName(options.ioprioClass, options.ioprioLevel))
+              .addInt("nice", options.niceness)
+              .addInt("latency_count", static_cast<long long>(latency.count()))
+              .addInt("latency_p50_ns", static_cast<long long>(latency.percentile(50)))
+              .addInt("latency_p99_ns", static_cast<long long>(latency.percentile(99)))
+              .addInt("latency_p999_ns", static_cast<long long>(latency.percentile(99.9)))
+              .addInt("latency_max_ns", static_cast<long long>(latency.maximum()));
+        
+        double generatePct, writePct;
+        string bound;
+        if (stageUtilization(totalTime, generatePct, writePct, bound)) {
+            record.addInt("pipeline_depth", pipelined() ? options.pipelineDepth : 0)
+                  .addNumber("generate_util_pct", generatePct, 1)
+                  .addNumber("write_util_pct", writePct, 1)
+                  .addText("bound", bound);
+        }
+        
+        if (checkpoint.active()) {
+            record.addText("checkpoint", checkpoint.location())
+                  .addInt("resume_checked_units", resumeChecked)
+                  .addInt("resume_repaired_units", resumeRepaired);
+        }
+        
+        if (batch) {
+            LatencyHistogram opens, closes;
+            double openPct, writePct, closePct;
+            batchPhaseShares(opens, closes, openPct, writePct, closePct);
+            long long files = filesCreated();
+            
+            record.addInt("files", files)
+                  .addNumber("files_per_sec", totalTime > 0 ? files / totalTime : 0, 1)
+                  .addInt("directories", directoriesCreated)
+                  .addNumber("mkdir_sec", mkdirTime, 6)
+                  .addInt("open_p50_ns", static_cast<long long>(opens.percentile(50)))
+                  .addInt("open_p99_ns", static_cast<long long>(opens.percentile(99)))
+                  .addInt("close_p50_ns", static_cast<long long>(closes.percentile(50)))
+                  .addInt("close_p99_ns", static_cast<long long>(closes.percentile(99)))
+                  .addNumber("open_share_pct", openPct, 1)
+                  .addNumber("write_share_pct", writePct, 1)
+                  .addNumber("close_share_pct", closePct, 1);
+        }
+        emitRecord(record);
+    }
+
+    // Creates the target and reserves its extents, falling back to the next weaker mode
+    bool preallocate() {
+        #ifdef _WIN32
+        ofstream file(fileName, ios::binary);
+        if (!file) return false;
+        
+        // Allocate-only runs write nothing, so the file is always sized
+        if (options.prealloc != PreallocMode::None || options.allocateOnly) {
+            file.seekp(fileSize - 1);
+            file.write("", 1);
+            preallocMethod = "seek + write";
+        } else {
+            preallocMethod = "none";
+        }
+        file.close();
+        return true;
+        #else
+        int fd = open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        
+        PreallocMode mode = options.prealloc;
+        bool allocated = false;
+        
+        #ifdef __linux__
+        if (mode == PreallocMode::ZeroRange) {
+            allocated = fallocate(fd, FALLOC_FL_ZERO_RANGE, 0, fileSize) == 0;
+            if (!allocated) mode = PreallocMode::Fallocate;
+        }
+        if (!allocated && mode == PreallocMode::Fallocate) {
+            allocated = fallocate(fd, 0, 0, fileSize) == 0;
+            if (!allocated) mode = PreallocMode::PosixFallocate;
+        }
+        #else
+        if (mode == PreallocMode::ZeroRange || mode == PreallocMode::Fallocate) {
+            mode = PreallocMode::PosixFallocate;
+        }
+        #endif
+        
+        #ifndef __APPLE__
+        if (!allocated && mode == PreallocMode::PosixFallocate) {
+            allocated = posix_fallocate(fd, 0, fileSize) == 0;
+        }
+        #endif
+        
+        bool ok = true;
+        if (allocated) {
+            preallocMethod = preallocName(mode);
+        } else if (mode == PreallocMode::None && options.backend != WriteBackend::Mmap && !options.allocateOnly) {
+            preallocMethod = "none";
+        } else {
+            // Nothing reserved blocks; still size the file so every range is addressable
+            ok = ftruncate(fd, fileSize) == 0;
+            preallocMethod = "sparse (ftruncate)";
+        }
+        
+        close(fd);
+        return ok;
+        #endif
+    }
+
+    // Random content is regenerated per write so no two blocks of the file repeat
+    void fillPattern(char* buffer, size_t size, long long offset) const {
+        if (!useRandomData) return;
+        // A stripe member's units carry the logical file's data, so the set reads back as one file
+        if (options.stripeCount > 1) {
+            long long unit = options.stripeUnit;
+            while (size > 0) {
+                long long within = offset % unit;
+                size_t piece = static_cast<size_t>(min(static_cast<long long>(size), unit - within));
+                generator.fill(buffer, piece, (offset / unit * options.stripeCount + options.stripeIndex) * unit + within);
+                buffer += piece;
+                size -= piece;
+                offset += piece;
+            }
+            return;
+        }
+        // A cloned file repeats its seed region, so the expected pattern wraps at the seed size
+        while (options.cloneSeed > 0 && size > 0) {
+            long long at = offset % options.cloneSeed;
+            size_t piece = static_cast<size_t>(min(static_cast<long long>(size), options.cloneSeed - at));
+            generator.fill(buffer, piece, at);
+            buffer += piece;
+            size -= piece;
+            offset += piece;
+        }
+        if (options.cloneSeed == 0) generator.fill(buffer, size, offset);
+    }
+
+    // Zero-filled runs share one read-only buffer; random data needs one per writer
+    char* writerBuffer(unique_ptr<AlignedBuffer>& owned, size_t size) {
+        if (!useRandomData && zeroBuffer && zeroBuffer->size() >= size) return zeroBuffer->data();
+        owned.reset(new AlignedBuffer(size));
+        return owned->data();
+    }
+
+    void prepareSharedBuffers() {
+        // The mmap engine fills the mapping itself and never reads a source buffer
+        bool needsSource = batch || options.backend != WriteBackend::Mmap;
+        // One shared buffer would sit on a single node, so with NUMA-local buffers each writer gets its own
+        bool spansNodes = options.numaLocal && CpuTopology::nodeCount() > 1;
+        if (!useRandomData && needsSource && !spansNodes) zeroBuffer.reset(new AlignedBuffer(static_cast<size_t>(bufferSizeMB) * 1024 * 1024));
+    }
+
+    // Applies --cpus, --numa-local, --ioprio and --nice to this writer; threads it starts inherit them
+    void placeWorker(int threadID) {
+        if (options.cpus.empty() && !options.numaLocal && options.ioprioClass == 0 && options.niceness == 0) return;
+        bool placed = true;
+        
+        #ifdef __linux__
+        if (!options.cpus.empty()) {
+            int cpu = options.cpus[threadID % options.cpus.size()];
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            if (cpu >= 0 && cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+            placed &= cpu >= 0 && cpu < CPU_SETSIZE && sched_setaffinity(0, sizeof(set), &set) == 0;
+        }
+        // After pinning, MPOL_LOCAL places every page this thread faults in on its current node
+        #ifdef SYS_set_mempolicy
+        const int MPOL_LOCAL_MODE = 4;
+        if (options.numaLocal) placed &= syscall(SYS_set_mempolicy, MPOL_LOCAL_MODE, nullptr, 0UL) == 0;
+        #endif
+        #ifdef SYS_ioprio_set
+        const int IOPRIO_WHO_THREAD = 1;    // IOPRIO_WHO_PROCESS with id 0 targets the calling thread
+        if (options.ioprioClass != 0) {
+            int value = (options.ioprioClass << 13) | (options.ioprioClass == 3 ? 0 : options.ioprioLevel);
+            placed &= syscall(SYS_ioprio_set, IOPRIO_WHO_THREAD, 0, value) == 0;
+        }
+        #endif
+        if (options.niceness != 0) {
+            id_t tid = static_cast<id_t>(syscall(SYS_gettid));
+            placed &= setpriority(PRIO_PROCESS, tid, getpriority(PRIO_PROCESS, tid) + options.niceness) == 0;
+        }
+        #elif defined(_WIN32)
+        // Only the CPU mask applies here; --numa-local, --ioprio and --nice count as refused
+        placed = !options.numaLocal && options.ioprioClass == 0 && options.niceness == 0;
+        if (!options.cpus.empty()) {
+            DWORD_PTR mask = static_cast<DWORD_PTR>(1) << (options.cpus[threadID % options.cpus.size()] % (8 * sizeof(DWORD_PTR)));
+            placed &= SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+        }
+        #else
+        (void)threadID;
+        placed = options.cpus.empty() && !options.numaLocal && options.ioprioClass == 0;
+        // Nice is per process here: set it from the starting value so workers do not stack
+        static const int processNice = getpriority(PRIO_PROCESS, 0);
+        if (options.niceness != 0) placed &= setpriority(PRIO_PROCESS, 0, processNice + options.niceness) == 0;
+        #endif
+        
+        if (!placed) placementFailures++;
+    }
+
+    // Drops CPUs outside this process's affinity mask (cgroup cpusets, taskset) before they are shown
+    void restrictCpus() {
+        if (options.cpus.empty()) return;
+        vector<int> allowed = CpuTopology::allowed();
+        vector<int> usable;
+        for (int cpu : options.cpus) {
+            if (find(allowed.begin(), allowed.end(), cpu) != allowed.end()) usable.push_back(cpu);
+            else droppedCpus.push_back(cpu);
+        }
+        options.cpus = usable;
+    }
+
+    void reportPlacement() {
+        if (!droppedCpus.empty()) {
+            reportWarning("Requested CPUs not available to this process: " + CpuTopology::format(droppedCpus) + ", "
+                          + (options.cpus.empty() ? "writers are left unpinned" : "pinning to the rest"));
+            droppedCpus.clear();
+        }
+        // Failures are only known once the writers ran, with the progress line still on screen
+        if (placementFailures > 0) {
+            reportWarning(to_string(placementFailures.load()) + " writer(s) could not apply the requested placement "
+                          "(realtime I/O priority and negative nice values need privileges)");
+            placementFailures = 0;
+        }
+    }
+
+    string cloneSummary() const {
+        vector<string> parts;
+        if (reflinkBytes > 0) parts.push_back(formatBytes(reflinkBytes.load()) + " reflinked");
+        if (copiedBytes > 0) parts.push_back(formatBytes(copiedBytes.load()) + " via copy_file_range");
+        if (rewrittenBytes > 0) parts.push_back(formatBytes(rewrittenBytes.load()) + " rewritten");
+        string text;
+        for (size_t i = 0; i < parts.size(); i++) text += (i ? ", " : "") + parts[i];
+        return text.empty() ? "nothing to clone" : text;
+    }
+
+    // Weakest mechanism any unit needed
+    string cloneMethodName() const {
+        if (rewrittenBytes > 0) return "rewrite";
+        if (copiedBytes > 0) return "copy_file_range";
+        return reflinkBytes > 0 ? "reflink" : "none";
+    }
+
+    // Sampled reduction check: dedup fingerprints over up to four groups, LZ on every 16th block
+    void estimateReduction() {
+        if (reductionEstimated || !useRandomData || !generator.shaped()) return;
+        reductionEstimated = true;
+        
+        long long window = min(fileSize, generator.groupBytes());
+        long long windows = min(4LL, max(1LL, fileSize / max(1LL, window)));
+        size_t chunk = static_cast<size_t>(options.dedupBlock);
+        AlignedBuffer buffer(chunk);
+        unordered_set<uint64_t> distinct;
+        long long chunks = 0, raw = 0, packed = 0;
+        
+        for (long long w = 0; w < windows; w++) {
+            long long start = fileSize / windows * w / generator.groupBytes() * generator.groupBytes();
+            for (long long pos = start; pos + options.dedupBlock <= min(fileSize, start + window); pos += options.dedupBlock) {
+                fillPattern(buffer.data(), chunk, pos);
+                uint32_t head;
+                memcpy(&head, buffer.data(), sizeof(head));
+                distinct.insert(static_cast<uint64_t>(Crc32c::compute(buffer.data(), chunk)) << 32 | head);
+                if (chunks++ % 16 == 0) {
+                    raw += PatternGenerator::BLOCK;
+                    packed += CompressEstimator::compressedSize(buffer.data(), PatternGenerator::BLOCK);
+                }
+            }
+        }
+        if (chunks == 0) return;
+        compressEstimate = static_cast<double>(raw) / max(1LL, packed);
+        dedupEstimate = static_cast<double>(chunks) / distinct.size();
+    }
+
+    string reductionSummary() const {
+        stringstream ss;
+        ss << fixed << setprecision(2) << "compress " << options.compressRatio << "x (est " << compressEstimate << "x), dedup "
+           << options.dedupRatio << "x (est " << dedupEstimate << "x per " << formatBytes(options.dedupBlock) << ")";
+        return ss.str();
+    }
+
+    static string ioprioName(int ioClass, int level) {
+        switch (ioClass) {
+            case 1: return "realtime:" + to_string(level);
+            case 2: return "best-effort:" + to_string(level);
+            case 3: return "idle";
+            default: return "inherited";
+        }
+    }
+
+    void timedFill(int threadID, char* buffer, size_t size, long long offset) {
+        if (!useRandomData) return;
+        auto start = steady_clock::now();
+        fillPattern(buffer, size, offset);
+        workerStats[threadID].generateNanos += duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    }
+
+    bool pipelined() const {
+        return useRandomData && options.pipelineDepth >= 2;
+    }
+
+    // Spin briefly, then back off, charging the wait to the given stall counter
+    static void stall(atomic<long long>& counter, int& spins) {
+        auto start = steady_clock::now();
+        if (++spins < 64) this_thread::yield();
+        else this_thread::sleep_for(microseconds(50));
+        counter += duration_cast<nanoseconds>(steady_clock::now() - start).count();
+    }
+
+    static string syncName(SyncMode mode) {
+        switch (mode) {
+            case SyncMode::None: return "none";
+            case SyncMode::End: return "end";
+            case SyncMode::Periodic: return "periodic";
+            case SyncMode::Rolling: return "rolling";
+        }
+        return "unknown";
+    }
+
+    // Opens the descriptor for in-run syncs; any descriptor of the file covers all of its data
+    void beginSync(int threadID) {
+        #ifndef _WIN32
+        if (options.sync == SyncMode::Periodic || options.sync == SyncMode::Rolling) {
+            workerStats[threadID].syncFd = openTarget(false);
+        }
+        #endif
+    }
+
+    void afterWrite(int threadID, long long offset, long long length) {
+        #ifndef _WIN32
+        WorkerStats& mine = workerStats[threadID];
+        if (mine.syncFd < 0) return;
+        
+        auto start = steady_clock::now();
+        if (options.sync == SyncMode::Periodic) {
+            // Whichever writer carries the shared byte count across an interval boundary syncs
+            long long every = static_cast<long long>(options.syncEveryMB) * 1024 * 1024;
+            long long before = syncCounter.fetch_add(length);
+            if (before / every != (before + length) / every) {
+                #ifdef __APPLE__
+                fsync(mine.syncFd);
+                #else
+                fdatasync(mine.syncFd);
+                #endif
+            }
+        }
+        #ifdef __linux__
+        else if (options.sync == SyncMode::Rolling) {
+            // Start writeback of this block and wait for the previous one: at most two dirty per writer
+            sync_file_range(mine.syncFd, offset, length, SYNC_FILE_RANGE_WRITE);
+            if (mine.pendingLength > 0) {
+                sync_file_range(mine.syncFd, mine.pendingOffset, mine.pendingLength,
+                                SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+                posix_fadvise(mine.syncFd, mine.pendingOffset, mine.pendingLength, POSIX_FADV_DONTNEED);
+            }
+            mine.pendingOffset = offset;
+            mine.pendingLength = length;
+        }
+        #endif
+        mine.syncNanos += duration_cast<nanoseconds>(steady_clock::now() - start).count();
+        #else
+        (void)threadID; (void)offset; (void)length;
+        #endif
+    }
+
+    void endSync(int threadID) {
+        #ifndef _WIN32
+        WorkerStats& mine = workerStats[threadID];
+        if (mine.syncFd < 0) return;
+        
+        #ifdef __linux__
+        if (mine.pendingLength > 0) {
+            auto start = steady_clock::now();
+            sync_file_range(mine.syncFd, mine.pendingOffset, mine.pendingLength,
+                            SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+            mine.syncNanos += duration_cast<nanoseconds>(steady_clock::now() - start).count();
+            mine.pendingLength = 0;
+        }
+        #endif
+        close(mine.syncFd);
+        mine.syncFd = -1;
+        #else
+        (void)threadID;
+        #endif
+    }
+
+    long long inRunSyncNanos() const {
+        long long total = 0;
+        for (int i = 0; i < workerStatsCount; i++) total += workerStats[i].syncNanos.load();
+        return total;
+    }
+
+    // Throughput the storage actually committed: includes the final flush unless --sync=none
+    double committedSpeed(double totalTime) const {
+        double elapsed = totalTime + flushTime;
+        return elapsed > 0 ? runBytes() / elapsed : 0;
+    }
+
+    // Bytes this run writes; a resumed run leaves out what the checkpoint already covers
+    long long runBytes() const {
+        return fileSize - resumedBytes;
+    }
+
+    // Sets up the unit bitmap, or on --resume restores it once the file is known to match
+    bool prepareCheckpoint() {
+        if (!options.resume) {
+            checkpoint.init(options.checkpointPath, fileSize, chunkUnit(fileSize, writerCount()), generator.seedValue(), useRandomData);
+            return true;
+        }
+        
+        string error;
+        if (!checkpoint.load(options.checkpointPath, fileSize, generator.seedValue(), useRandomData, error)) {
+            reportError(error);
+            return false;
+        }
+        ifstream existing(fileName, ios::binary | ios::ate);
+        if (!existing || static_cast<long long>(existing.tellg()) != fileSize) {
+            reportError("'" + fileName + "' is missing or no longer " + formatBytes(fileSize) + ", cannot resume");
+            return false;
+        }
+        existing.close();
+        
+        #ifndef _WIN32
+        if (options.resumeVerifyUnits > 0) spotVerify(options.resumeVerifyUnits);
+        #endif
+        skipUnits = checkpoint.doneUnits();
+        resumedBytes = checkpoint.doneBytes();
+        windowBytes = resumedBytes;
+        bytesWritten = 0;
+        return true;
+    }
+
+    // Snapshot before the flush, so the bitmap never claims data that is not on the device
+    bool saveCheckpoint() const {
+        vector<uint64_t> state = checkpoint.snapshot();
+        #ifndef _WIN32
+        if (options.sync != SyncMode::None) flushToDevice();
+        #endif
+        return checkpoint.save(state);
+    }
+
+    // Runs beside the monitor, since the flush before each save can take seconds on a large file
+    void saveCheckpoints() {
+        auto lastSave = steady_clock::now();
+        while (!checkpointStop) {
+            this_thread::sleep_for(milliseconds(50));
+            if (duration<double>(steady_clock::now() - lastSave).count() < 5.0) continue;
+            saveCheckpoint();
+            lastSave = steady_clock::now();
+        }
+    }
+
+    // Under a rate limit a block goes out in burst-sized writes, each waiting for its own credit
+    template <typename WriteBlock>
+    bool writeTimed(int threadID, WriteBlock& writeBlock, const char* data, size_t length, long long offset) {
+        for (size_t done = 0; done < length; ) {
+            size_t part = min(length - done, pacedSlice);
+            long long at = offset + static_cast<long long>(done);
+            limiter.acquire(static_cast<long long>(part));
+            auto writeStart = steady_clock::now();
+            if (!writeBlock(data + done, part, at)) return false;
+            
+            recordLatency(threadID, writeStart);
+            recordWrite(threadID, part);
+            afterWrite(threadID, at, static_cast<long long>(part));
+            done += part;
+        }
+        return true;
+    }
+
+    // Hands claimed blocks to writeBlock, generated ahead with --pipeline >= 2; `retain` keeps blocks out of the ring
+    template <typename WriteBlock>
+    void writeUnits(int threadID, size_t bufSize, bool splitTail, WriteBlock writeBlock, unsigned retain = 0) {
+        WorkerStats& mine = workerStats[threadID];
+        long long startPos, endPos, offset;
+        size_t length;
+        // A parked writer allocates nothing until the controller first admits it
+        if (!admitted(threadID)) return;
+        
+        if (!pipelined()) {
+            unique_ptr<AlignedBuffer> owned;
+            char* buffer = writerBuffer(owned, bufSize);
+            
+            while (!errorFlag && admitted(threadID) && scheduler.next(startPos, endPos)) {
+                BlockCursor cursor(startPos, endPos, bufSize, splitTail);
+                while (!errorFlag && cursor.next(offset, length)) {
+                    timedFill(threadID, buffer, length, offset);
+                    if (!writeTimed(threadID, writeBlock, buffer, length, offset)) errorFlag = true;
+                }
+                if (errorFlag) break;
+                markUnitDone(startPos);
+                mine.units++;
+            }
+            return;
+        }
+        
+        struct Block {
+            unique_ptr<AlignedBuffer> buffer;
+            long long offset;
+            size_t length;
+            long long unitStart;
+            bool unitEnd;   // Last block of its unit: writing it completes the unit
+        };
+        
+        unsigned depth = max(static_cast<unsigned>(min(options.pipelineDepth, 16)), retain + 2);
+        vector<Block> blocks(depth);
+        vector<unsigned> held;
+        SpscRing filled(depth);
+        SpscRing empty(depth);
+        for (unsigned i = 0; i < depth; i++) {
+            blocks[i].buffer.reset(new AlignedBuffer(bufSize));
+            empty.push(i);
+        }
+        atomic<bool> generatorDone{false};
+        
+        thread generatorStage([&] {
+            long long start, end, at;
+            size_t len;
+            while (!errorFlag && admitted(threadID) && scheduler.next(start, end)) {
+                BlockCursor cursor(start, end, bufSize, splitTail);
+                while (!errorFlag && cursor.next(at, len)) {
+                    unsigned idx = 0;
+                    int spins = 0;
+                    while (!empty.pop(idx)) {
+                        if (errorFlag) break;
+                        stall(mine.generateStallNanos, spins);
+                    }
+                    if (errorFlag) break;
+                    
+                    timedFill(threadID, blocks[idx].buffer->data(), len, at);
+                    blocks[idx].offset = at;
+                    blocks[idx].length = len;
+                    blocks[idx].unitStart = start;
+                    blocks[idx].unitEnd = at + static_cast<long long>(len) == end;
+                    filled.push(idx);
+                }
+            }
+            generatorDone.store(true, memory_order_release);
+        });
+        
+        int spins = 0;
+        while (!errorFlag) {
+            unsigned idx;
+            if (!filled.pop(idx)) {
+                // The generator publishes its last block before the done flag, so re-check after reading it
+                bool done = generatorDone.load(memory_order_acquire);
+                if (!filled.pop(idx)) {
+                    if (done) break;
+                    stall(mine.writeStallNanos, spins);
+                    continue;
+                }
+            }
+            spins = 0;
+            
+            Block& block = blocks[idx];
+            if (!writeTimed(threadID, writeBlock, block.buffer->data(), block.length, block.offset)) errorFlag = true;
+            else if (block.unitEnd) {
+                markUnitDone(block.unitStart);
+                mine.units++;
+            }
+            
+            held.push_back(idx);
+            if (held.size() > retain) {
+                empty.push(held.front());
+                held.erase(held.begin());
+            }
+        }
+        
+        generatorStage.join();
+    }
+
+    // Adaptive mode parks writers at or above the controller's limit before they claim more work
+    bool admitted(int threadID) {
+        while (threadID >= writerLimit.load(memory_order_relaxed) && !errorFlag && !scheduler.drained()) {
+            this_thread::sleep_for(milliseconds(2));
+        }
+        return !errorFlag;
+    }
+
+    void markUnitDone(long long unitStart) {
+        if (checkpoint.active()) checkpoint.markDone(unitStart / scheduler.unit());
+    }
+
+    void recordWrite(int threadID, long long bytes) {
+        bytesWritten += bytes;
+        workerStats[threadID].bytes += bytes;
+        stats.operationCount++;
+    }
+
+    void recordLatency(int threadID, steady_clock::time_point started) {
+        auto nanos = duration_cast<nanoseconds>(steady_clock::now() - started).count();
+        workerStats[threadID].writeLatency.record(static_cast<uint64_t>(nanos));
+    }
+
+    void turboWriter(int threadID) {
+        try {
+            activeWorkers++;
+            placeWorker(threadID);
+            
+            size_t bufSize = static_cast<size_t>(bufferSizeMB) * 1024 * 1024;
+            
+            ofstream file(fileName, ios::binary | ios::in | ios::out);
+            if (!file) {
+                errorFlag = true;
+                activeWorkers--;
+                return;
+            }
+            
+            file.rdbuf()->pubsetbuf(nullptr, 0);
+            beginSync(threadID);
+            writeUnits(threadID, bufSize, false, [&](const char* data, size_t length, long long offset) {
+                file.seekp(offset);
+                file.write(data, length);
+                return file.good();
+            });
+            endSync(threadID);
+            
+            file.close();
+            activeWorkers--;
+            
+        } catch (...) {
+            errorFlag = true;
+            activeWorkers--;
+        }
+    }
+
+#ifndef _WIN32
+    int openTarget(bool direct) const {
+        int flags = O_WRONLY;
+        #ifdef O_DIRECT
+        if (direct) flags |= O_DIRECT;
+        #endif
+        int fd = open(fileName.c_str(), flags);
+        #if !defined(O_DIRECT) && defined(F_NOCACHE)
+        if (fd >= 0 && direct) fcntl(fd, F_NOCACHE, 1);
+        #endif
+        return fd;
+    }
+
+    bool pwriteAll(int fd, const char* data, size_t length, long long offset) {
+        while (length > 0) {
+            ssize_t written = pwrite(fd, data, length, offset);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return false;
+            
+            data += written;
+            length -= written;
+            offset += written;
+        }
+        return true;
+    }
+
+    bool pwriteBuffered(const char* data, size_t length, long long offset) {
+        int fd = openTarget(false);
+        if (fd < 0) return false;
+        
+        bool ok = pwriteAll(fd, data, length, offset);
+        close(fd);
+        return ok;
+    }
+
+    // O_DIRECT can only move whole blocks, so the sub-block tail goes through the page cache
+    bool writeUnalignedTail(int threadID, char* data, long long startPos, long long endPos) {
+        if (startPos >= endPos) return true;
+        
+        size_t length = static_cast<size_t>(endPos - startPos);
+        fillPattern(data, length, startPos);
+        
+        limiter.acquire(static_cast<long long>(length));
+        auto writeStart = steady_clock::now();
+        bool ok = pwriteBuffered(data, length, startPos);
+        if (ok) {
+            recordLatency(threadID, writeStart);
+            recordWrite(threadID, length);
+        }
+        return ok;
+    }
+
+    // Stream engine in direct mode: ofstream cannot open with O_DIRECT, so use pwrite on an aligned buffer
+    void directWriter(int threadID) {
+        activeWorkers++;
+        placeWorker(threadID);
+        int fd = -1;
+        
+        try {
+            size_t bufSize = static_cast<size_t>(bufferSizeMB) * 1024 * 1024;
+            
+            fd = openTarget(true);
+            if (fd < 0) {
+                errorFlag = true;
+                activeWorkers--;
+                return;
+            }
+            
+            // Units are 4 KB aligned, so only the block ending at EOF can be partial; it goes through the page cache
+            beginSync(threadID);
+            writeUnits(threadID, bufSize, true, [&](const char* data, size_t length, long long offset) {
+                if (length % AlignedBuffer::ALIGNMENT) return pwriteBuffered(data, length, offset);
+                return pwriteAll(fd, data, length, offset);
+            });
+            endSync(threadID);
+            
+            close(fd);
+            activeWorkers--;
+            
+        } catch (...) {
+            errorFlag = true;
+            if (fd >= 0) close(fd);
+            activeWorkers--;
+        }
+    }
+
+    // Generates straight into the page cache through a mapping of each unit; the file must be sized
+    void mmapWriter(int threadID) {
+        activeWorkers++;
+        placeWorker(threadID);
+        int fd = -1;
+        
+        try {
+            size_t slice = min(static_cast<size_t>(bufferSizeMB) * 1024 * 1024, pacedSlice);
+            long long pageSize = max(4096L, sysconf(_SC_PAGESIZE));
+            
+            fd = open(fileName.c_str(), O_RDWR);
+            if (fd < 0) {
+                errorFlag = true;
+                activeWorkers--;
+                return;
+            }
+            beginSync(threadID);
+            
+            long long startPos, endPos;
+            while (!errorFlag && admitted(threadID) && scheduler.next(startPos, endPos)) {
+                long long mapStart = startPos & ~(pageSize - 1);
+                size_t mapLength = static_cast<size_t>(endPos - mapStart);
+                
+                void* mapped = mmap(nullptr, mapLength, PROT_READ | PROT_WRITE, MAP_SHARED, fd, mapStart);
+                if (mapped == MAP_FAILED) {
+                    errorFlag = true;
+                    break;
+                }
+                
+                if (options.madvise == MadvisePolicy::Sequential) {
+                    madvise(mapped, mapLength, MADV_SEQUENTIAL);
+                }
+                #ifdef MADV_HUGEPAGE
+                if (options.madvise == MadvisePolicy::HugePage) {
+                    madvise(mapped, mapLength, MADV_HUGEPAGE);
+                }
+                #endif
+                
+                // Latency here is the page-fault and fill cost of each slice
+                char* base = static_cast<char*>(mapped) + (startPos - mapStart);
+                for (long long pos = startPos; pos < endPos && !errorFlag; ) {
+                    size_t length = static_cast<size_t>(min(static_cast<long long>(slice), endPos - pos));
+                    limiter.acquire(static_cast<long long>(length));
+                    
+                    auto writeStart = steady_clock::now();
+                    char* dst = base + (pos - startPos);
+                    if (useRandomData) fillPattern(dst, length, pos);
+                    else memset(dst, 0, length);
+                    
+                    recordLatency(threadID, writeStart);
+                    recordWrite(threadID, length);
+                    pos += length;
+                }
+                
+                if (options.msync != MsyncPolicy::None) {
+                    if (msync(mapped, mapLength, options.msync == MsyncPolicy::Sync ? MS_SYNC : MS_ASYNC) != 0) {
+                        errorFlag = true;
+                    }
+                }
+                munmap(mapped, mapLength);
+                afterWrite(threadID, startPos, endPos - startPos);
+                if (!errorFlag) markUnitDone(startPos);
+                workerStats[threadID].units++;
+            }
+            
+            endSync(threadID);
+            close(fd);
+            activeWorkers--;
+            
+        } catch (...) {
+            errorFlag = true;
+            if (fd >= 0) close(fd);
+            activeWorkers--;
+        }
+    }
+
+    // Times an fdatasync so write-back still sitting in the page cache is charged to the device
+    double flushToDevice() const {
+        auto start = steady_clock::now();
+        int fd = open(fileName.c_str(), O_WRONLY);
+        if (fd < 0) return 0;
+        
+        #ifdef __APPLE__
+        fsync(fd);
+        #else
+        fdatasync(fd);
+        #endif
+        close(fd);
+        return duration<double>(steady_clock::now() - start).count();
+    }
+
+    // Re-reads sampled finished units; one that lost its pattern is cleared and written again
+    void spotVerify(int samples) {
+        vector<long long> done;
+        for (long long i = 0; i < checkpoint.unitCount(); i++) {
+            if (checkpoint.isDone(i)) done.push_back(i);
+        }
+        if (done.empty()) return;
+        
+        int fd = open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        
+        size_t bufSize = static_cast<size_t>(bufferSizeMB) * 1024 * 1024;
+        AlignedBuffer actual(bufSize);
+        AlignedBuffer expected(bufSize);
+        size_t stride = max(static_cast<size_t>(1), done.size() / static_cast<size_t>(samples));
+        
+        for (size_t k = 0; k < done.size() && resumeChecked < samples; k += stride) {
+            long long unitStart = done[k] * checkpoint.unit();
+            long long unitEnd = min(fileSize, unitStart + checkpoint.unit());
+            bool intact = true;
+            
+            for (long long pos = unitStart; intact && pos < unitEnd; ) {
+                size_t length = static_cast<size_t>(min(static_cast<long long>(bufSize), unitEnd - pos));
+                long long got = preadFull(fd, actual.data(), length, pos);
+                memset(expected.data(), 0, length);
+                fillPattern(expected.data(), length, pos);
+                intact = got == static_cast<long long>(length) && memcmp(actual.data(), expected.data(), length) == 0;
+                pos += length;
+            }
+            
+            resumeChecked++;
+            if (!intact) {
+                checkpoint.clear(done[k]);
+                resumeRepaired++;
+            }
+        }
+        close(fd);
+    }
+
+    // Returns the number of bytes read (short only at EOF), or -1 on I/O error
+    static long long preadFull(int fd, char* data, size_t length, long long offset) {
+        long long total = 0;
+        while (length > 0) {
+            ssize_t got = pread(fd, data, length, offset);
+            if (got < 0 && errno == EINTR) continue;
+            if (got < 0) return -1;
+            if (got == 0) break;
+            
+            data += got;
+            length -= got;
+            offset += got;
+            total += got;
+        }
+        return total;
+    }
+
+    void recordMismatch(long long offset) {
+        long long current = firstMismatch.load();
+        while (offset < current && !firstMismatch.compare_exchange_weak(current, offset));
+    }
+
+    // Reads claimed units back and compares every buffer byte for byte against regenerated content
+    void verifyWorker() {
+        activeWorkers++;
+        int directFd = -1;
+        int bufferedFd = -1;
+        
+        try {
+            size_t bufSize = static_cast<size_t>(bufferSizeMB) * 1024 * 1024;
+            AlignedBuffer actual(bufSize);
+            AlignedBuffer expected(bufSize);
+            
+            auto checkRange = [&](int fd, long long from, long long to) {
+                long long pos = from;
+                while (pos < to && pos < firstMismatch.load() && !errorFlag) {
+                    size_t length = static_cast<size_t>(min(static_cast<long long>(bufSize), to - pos));
+                    
+                    long long got = preadFull(fd, actual.data(), length, pos);
+                    if (got < 0) {
+                        errorFlag = true;
+                        return;
+                    }
+                    
+                    fillPattern(expected.data(), length, pos);
+                    if (static_cast<size_t>(got) < length || memcmp(actual.data(), expected.data(), length) != 0) {
+                        size_t i = 0;
+                        while (i < static_cast<size_t>(got) && actual.data()[i] == expected.data()[i]) i++;
+                        recordMismatch(pos + i);
+                        return;
+                    }
+                    
+                    pos += length;
+                    bytesVerified += length;
+                    stats.operationCount++;
+                }
+            };
+            
+            bufferedFd = open(fileName.c_str(), O_RDONLY);
+            if (options.directIO) {
+                int flags = O_RDONLY;
+                #ifdef O_DIRECT
+                flags |= O_DIRECT;
+                #endif
+                directFd = open(fileName.c_str(), flags);
+            }
+            if (bufferedFd < 0 || (options.directIO && directFd < 0)) errorFlag = true;
+            
+            // Units are claimed in increasing order, so once a mismatch is known nothing new can beat it
+            long long startPos, endPos;
+            while (!errorFlag && firstMismatch.load() == LLONG_MAX && scheduler.next(startPos, endPos)) {
+                long long directEnd = options.directIO ? max(startPos, AlignedBuffer::alignDown(endPos)) : startPos;
+                checkRange(directFd, startPos, directEnd);
+                checkRange(bufferedFd, directEnd, endPos);
+            }
+            
+            if (directFd >= 0) close(directFd);
+            if (bufferedFd >= 0) close(bufferedFd);
+            activeWorkers--;
+            
+        } catch (...) {
+            errorFlag = true;
+            if (directFd >= 0) close(directFd);
+            if (bufferedFd >= 0) close(bufferedFd);
+            activeWorkers--;
+        }
+    }
+
+    // Clone mode: write this worker's share of the seed, wait for the whole seed, then replicate it
+    void seedThenClone(void (TurboFileCreator::*writer)(int), int threadID) {
+        (this->*writer)(threadID);
+        seedWriters--;
+        while (seedWriters > 0 && !errorFlag) this_thread::sleep_for(milliseconds(1));
+        if (!errorFlag) cloneUnits(threadID);
+    }
+
+    // Copies the seed [0, cloneSeed) over one seed-sized unit per claim
+    void cloneUnits(int threadID) {
+        activeWorkers++;
+        int fd = open(fileName.c_str(), O_RDWR);
+        if (fd < 0) errorFlag = true;
+        
+        try {
+            unique_ptr<AlignedBuffer> bounce;
+            long long start, end;
+            while (!errorFlag && cloneScheduler.next(start, end)) {
+                limiter.acquire(end - start);
+                auto cloneStart = steady_clock::now();
+                if (!cloneRange(fd, options.cloneSeed + start, end - start, bounce)) {
+                    errorFlag = true;
+                    break;
+                }
+                recordLatency(threadID, cloneStart);
+                recordWrite(threadID, end - start);
+                workerStats[threadID].units++;
+            }
+        } catch (...) {
+            errorFlag = true;
+        }
+        
+        if (fd >= 0) close(fd);
+        activeWorkers--;
+    }
+
+    // Reflink, then copy_file_range, then pread/pwrite; a refused mechanism is dropped for all workers
+    bool cloneRange(int fd, long long dest, long long length, unique_ptr<AlignedBuffer>& bounce) {
+        long long source = 0;
+        
+        #if defined(__linux__) && defined(FICLONERANGE)
+        if (cloneMethod.load() == static_cast<int>(CloneMethod::Reflink)) {
+            struct file_clone_range range;
+            range.src_fd = fd;
+            range.src_offset = 0;
+            range.src_length = static_cast<uint64_t>(length);
+            range.dest_offset = static_cast<uint64_t>(dest);
+            if (ioctl(fd, FICLONERANGE, &range) == 0) {
+                reflinkBytes += length;
+                return true;
+            }
+            bool unalignedTail = errno == EINVAL && length % AlignedBuffer::ALIGNMENT != 0;
+            if (!unalignedTail) {
+                int expected = static_cast<int>(CloneMethod::Reflink);
+                cloneMethod.compare_exchange_strong(expected, static_cast<int>(CloneMethod::Copy));
+            }
+        }
+        #endif
+        
+        #if defined(__linux__) && defined(SYS_copy_file_range)
+        if (cloneMethod.load() <= static_cast<int>(CloneMethod::Copy)) {
+            long long copied = 0;
+            while (copied < length) {
+                loff_t in = source + copied;
+                loff_t out = dest + copied;
+                long moved = syscall(SYS_copy_file_range, fd, &in, fd, &out, static_cast<size_t>(length - copied), 0U);
+                if (moved < 0 && errno == EINTR) continue;
+                if (moved <= 0) break;
+                copied += moved;
+            }
+            copiedBytes += copied;
+            if (copied == length) return true;
+            if (copied == 0) {
+                int expected = static_cast<int>(CloneMethod::Copy);
+                cloneMethod.compare_exchange_strong(expected, static_cast<int>(CloneMethod::Rewrite));
+            }
+            source += copied;
+            dest += copied;
+            length -= copied;
+        }
+        #endif
+        
+        size_t bufSize = static_cast<size_t>(bufferSizeMB) * 1024 * 1024;
+        if (!bounce) bounce.reset(new AlignedBuffer(bufSize));
+        while (length > 0) {
+            size_t piece = static_cast<size_t>(min(static_cast<long long>(bufSize), length));
+            if (preadFull(fd, bounce->data(), piece, source) != static_cast<long long>(piece)) return false;
+            if (!pwriteAll(fd, bounce->data(), piece, dest)) return false;
+            rewrittenBytes += piece;
+            source += piece;
+            dest += piece;
+            length -= piece;
+        }
+        return true;
+    }
+
+#endif
+
+    // Parallel readback against content regenerated from the seed
+    bool verify() {
+        if (view()) view()->verifying(*this);
+        
+        #ifdef _WIN32
+        reportError("Verification is not supported on this platform");
+        return false;
+        #else
+        struct stat info;
+        if (stat(fileName.c_str(), &info) != 0) {
+            reportError("Cannot open file for verification");
+            return false;
+        }
+        
+        long long actualSize = static_cast<long long>(info.st_size);
+        long long checkSize = min(actualSize, fileSize);
+        
+        // Drop cached pages so buffered readback comes from the device rather than RAM
+        #ifdef POSIX_FADV_DONTNEED
+        if (!options.directIO) {
+            int fd = open(fileName.c_str(), O_RDONLY);
+            if (fd >= 0) {
+                posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+                close(fd);
+            }
+        }
+        #endif
+        
+        bytesVerified = 0;
+        firstMismatch = actualSize < fileSize ? actualSize : LLONG_MAX;
+        errorFlag = cancelRequested.load();
+        
+        if (view()) view()->running(*this);
+        auto startTime = steady_clock::now();
+        
+        vector<thread> workers;
+        scheduler.reset(checkSize, chunkUnit(checkSize, numThreads));
+        
+        for (int i = 0; i < numThreads; i++) {
+            workers.emplace_back(&TurboFileCreator::verifyWorker, this);
+        }
+        
+        while (bytesVerified < checkSize && !errorFlag && firstMismatch.load() == LLONG_MAX) {
+            this_thread::sleep_for(milliseconds(50));
+            double elapsed = duration<double>(steady_clock::now() - startTime).count();
+            if (view()) view()->verifyProgress(*this, bytesVerified.load(), checkSize, elapsed);
+        }
+        
+        for (auto& worker : workers) {
+            if (worker.joinable()) worker.join();
+        }
+        
+        double totalTime = duration<double>(steady_clock::now() - startTime).count();
+        bool passed = !errorFlag && firstMismatch.load() == LLONG_MAX && actualSize == fileSize;
+        double readSpeed = totalTime > 0 ? bytesVerified.load() / totalTime : 0;
+        
+        if (headless()) {
+            StructuredRecord record("verify");
+            record.addText("file", fileName)
+                  .addBool("passed", passed)
+                  .addInt("bytes_verified", bytesVerified.load())
+                  .addInt("expected_size", fileSize)
+                  .addInt("size_on_disk", actualSize)
+                  .addNumber("elapsed_sec", totalTime, 6)
+                  .addNumber("read_bps", readSpeed, 0)
+                  .addInt("first_mismatch", firstMismatch.load() == LLONG_MAX ? -1 : firstMismatch.load())
+                  .addBool("read_error", errorFlag.load());
+            emitRecord(record);
+            return passed;
+        }
+        
+        if (view()) view()->verified(*this, passed, actualSize, totalTime);
+        return passed;
+        #endif
+    }
+
+#ifdef TURBO_HAVE_IO_URING
+    // One submitter keeps queueDepth writes in flight, each in its own registered buffer slot
+    void uringWriter(int threadID) {
+        struct Slot {
+            char* data;
+            long long offset;
+            size_t length;
+            size_t done;
+            steady_clock::time_point submitted;
+        };
+
+        activeWorkers++;
+        placeWorker(threadID);
+        int fd = -1;
+
+        try {
+            unsigned depth = static_cast<unsigned>(max(1, options.queueDepth));
+            size_t bufSize = static_cast<size_t>(bufferSizeMB) * 1024 * 1024;
+            size_t slotSize = min(max<size_t>(64 * 1024, (bufSize / depth) & ~static_cast<size_t>(4095)), pacedSlice);
+
+            UringQueue ring;
+            fd = openTarget(options.directIO);
+            if (fd < 0) {
+                noteFailure("Cannot open " + fileName, errno);
+                activeWorkers--;
+                return;
+            }
+            if (!ring.init(depth)) {
+                noteFailure("io_uring setup failed", errno);
+                close(fd);
+                activeWorkers--;
+                return;
+            }
+
+            // Zero-filled slots all point at the shared zero buffer, registered once as index 0
+            bool sharedZero = !useRandomData && zeroBuffer && zeroBuffer->size() >= slotSize;
+            unique_ptr<AlignedBuffer> owned;
+            char* pool = sharedZero ? zeroBuffer->data() : writerBuffer(owned, slotSize * depth);
+            vector<Slot> slots(depth);
+            vector<iovec> iovs(sharedZero ? 1 : depth);
+            vector<unsigned> freeSlots;
+            for (unsigned i = 0; i < depth; i++) {
+                slots[i].data = sharedZero ? pool : pool + i * slotSize;
+                freeSlots.push_back(depth - 1 - i);
+            }
+            for (size_t i = 0; i < iovs.size(); i++) {
+                iovs[i].iov_base = slots[i].data;
+                iovs[i].iov_len = slotSize;
+            }
+
+            // Fixed buffers skip per-I/O page pinning; fall back to plain writes if the kernel refuses
+            bool fixedBuffers = ring.registerBuffers(iovs);
+            beginSync(threadID);
+
+            // A full submission ring drains on submit; retry once before giving up
+            auto queueSlot = [&](unsigned idx) {
+                io_uring_sqe* sqe = ring.nextSqe();
+                if (!sqe && ring.submitAndWait(0)) sqe = ring.nextSqe();
+                if (!sqe) {
+                    noteFailure("io_uring submission queue stayed full", EBUSY);
+                    return false;
+                }
+                Slot& slot = slots[idx];
+                sqe->opcode = fixedBuffers ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+                sqe->fd = fd;
+                sqe->off = static_cast<unsigned long long>(slot.offset + slot.done);
+                sqe->addr = reinterpret_cast<unsigned long long>(slot.data + slot.done);
+                sqe->len = static_cast<unsigned>(slot.length - slot.done);
+                sqe->buf_index = static_cast<unsigned short>(sharedZero ? 0 : idx);
+                sqe->user_data = idx;
+                return true;
+            };
+
+            long long pos = 0;
+            long long ringEnd = 0;
+            long long tailStart = 0;
+            long long tailEnd = 0;
+            unsigned inFlight = 0;
+            
+            // Slots of one unit complete out of order; a unit is done when its last byte lands
+            unordered_map<long long, long long> unitRemaining;
+            auto settleUnit = [&](long long offset, long long length) {
+                long long unitStart = offset - offset % scheduler.unit();
+                auto it = unitRemaining.find(unitStart);
+                if (it == unitRemaining.end() || (it->second -= length) > 0) return;
+                unitRemaining.erase(it);
+                // The unit holding the deferred tail is only done once the tail is written
+                if (tailEnd == 0 || unitStart != tailStart - tailStart % scheduler.unit()) markUnitDone(unitStart);
+            };
+
+            // Pulls the next unit from the scheduler; a sub-block tail at EOF is deferred in direct mode
+            auto claimUnit = [&]() {
+                long long startPos, endPos;
+                while (scheduler.next(startPos, endPos)) {
+                    workerStats[threadID].units++;
+                    long long alignedEnd = options.directIO ? max(startPos, AlignedBuffer::alignDown(endPos)) : endPos;
+                    if (alignedEnd < endPos) {
+                        tailStart = alignedEnd;
+                        tailEnd = endPos;
+                    }
+                    if (alignedEnd > startPos) {
+                        pos = startPos;
+                        ringEnd = alignedEnd;
+                        unitRemaining[startPos] = alignedEnd - startPos;
+                        return true;
+                    }
+                }
+                return false;
+            };
+
+            bool unitsLeft = true;
+            while (!errorFlag) {
+                while (!freeSlots.empty()) {
+                    if (pos >= ringEnd && (!unitsLeft || !claimUnit())) {
+                        unitsLeft = false;
+                        break;
+                    }
+
+                    unsigned idx = freeSlots.back();
+                    freeSlots.pop_back();
+
+                    slots[idx].offset = pos;
+                    slots[idx].length = static_cast<size_t>(min(static_cast<long long>(slotSize), ringEnd - pos));
+                    slots[idx].done = 0;
+                    timedFill(threadID, slots[idx].data, slots[idx].length, pos);
+                    limiter.acquire(static_cast<long long>(slots[idx].length));
+                    slots[idx].submitted = steady_clock::now();
+                    if (!queueSlot(idx)) break;
+
+                    pos += slots[idx].length;
+                    inFlight++;
+                }
+
+                if (inFlight == 0 || errorFlag) break;
+                if (!ring.submitAndWait(1)) {
+                    noteFailure("io_uring submit failed", errno);
+                    break;
+                }
+
+                ring.reap([&](unsigned long long userData, int result) {
+                    unsigned idx = static_cast<unsigned>(userData);
+                    Slot& slot = slots[idx];
+
+                    if (result <= 0) {
+                        noteFailure("io_uring write failed", result < 0 ? -result : EIO);
+                        inFlight--;
+                        return;
+                    }
+
+                    recordWrite(threadID, result);
+
+                    slot.done += result;
+                    if (slot.done < slot.length) {
+                        // Short write: resubmit the remainder from the same slot
+                        if (!queueSlot(idx)) inFlight--;
+                        return;
+                    }
+
+                    // Latency spans submission to final completion, including any short-write retries
+                    recordLatency(threadID, slot.submitted);
+                    afterWrite(threadID, slot.offset, static_cast<long long>(slot.length));
+                    settleUnit(slot.offset, static_cast<long long>(slot.length));
+                    inFlight--;
+                    freeSlots.push_back(idx);
+                });
+            }
+
+            // Drain anything still owned by the kernel before the buffers go away
+            while (inFlight > 0 && ring.submitAndWait(1)) {
+                inFlight -= ring.reap([](unsigned long long, int) {});
+            }
+
+            endSync(threadID);
+            close(fd);
+            if (!errorFlag && !writeUnalignedTail(threadID, pool, tailStart, tailEnd)) {
+                errorFlag = true;
+            }
+            if (!errorFlag && tailEnd > tailStart) markUnitDone(tailStart - tailStart % scheduler.unit());
+            activeWorkers--;
+
+        } catch (...) {
+            errorFlag = true;
+            if (fd >= 0) close(fd);
+            activeWorkers--;
+        }
+    }
+#endif
+
+    // Single writer, since a pipe has one position; with vmsplice the last block stays out of the ring
+    void streamWriter(int threadID) {
+        activeWorkers++;
+        placeWorker(threadID);
+        
+        #ifndef _WIN32
+        // A departed reader must surface as EPIPE, not kill the host; SIGPIPE goes to this thread
+        sigset_t pipeSignal;
+        sigemptyset(&pipeSignal);
+        sigaddset(&pipeSignal, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &pipeSignal, nullptr);
+        #endif
+        
+        try {
+            size_t bufSize = static_cast<size_t>(bufferSizeMB) * 1024 * 1024;
+            unsigned retain = sink.path() == StreamSink::Path::Vmsplice && useRandomData ? 1 : 0;
+            writeUnits(threadID, bufSize, false, [&](const char* data, size_t length, long long) {
+                return sink.write(data, length);
+            }, retain);
+        } catch (...) {
+            errorFlag = true;
+        }
+        activeWorkers--;
+    }
+
+    // Batch mode, defined in file_creator_batch.hpp
+    static bool makeDirectory(const string& path, bool& created);
+    void batchWriter(int threadID);
+    long long filesCreated() const;
+    void batchPhaseShares(LatencyHistogram& opens, LatencyHistogram& closes, double& openPct, double& writePct, double& closePct) const;
+
+    // Workload mode, defined in file_creator_workload.hpp
+    void workloadWorker(int threadID);
+    static string distributionName(OffsetDistribution distribution, double theta);
+    void trackWorkload(long long reads, long long writes, double elapsed, double limit);
+    void workloadTotals(LatencyHistogram& reads, LatencyHistogram& writes, long long& readBytes, long long& writeBytes) const;
+    void addOpFields(StructuredRecord& record, const string& prefix, const LatencyHistogram& latency, long long bytes, double totalTime);
+
+public:
+    TurboFileCreator(const string& filename, long long size, int threads = 4, 
+                     int bufferMB = 32, bool randomData = false, bool turbo = true,
+                     const CreatorOptions& opts = CreatorOptions()) 
+        : fileName(filename), fileSize(size), numThreads(threads), 
+          bufferSizeMB(bufferMB), useRandomData(randomData), turboMode(turbo), options(opts),
+          generator(opts.seed) {
+        progressTotal = fileSize;
+        if (numThreads <= 0) {
+            numThreads = max(1u, thread::hardware_concurrency());
+        }
+        
+        if (turboMode) {
+            bufferSizeMB = max(bufferSizeMB, 32);
+            numThreads = max(numThreads, 4);
+        }
+        
+        options.queueDepth = max(1, min(options.queueDepth, 4096));
+        options.submitters = max(1, options.submitters);
+        options.syncEveryMB = max(1, options.syncEveryMB);
+        #ifndef __linux__
+        if (options.sync == SyncMode::Rolling) options.sync = SyncMode::Periodic;
+        #endif
+        // Reflinks and copy_file_range work on whole 4 KB blocks; a seed as large as the file is just a write
+        options.cloneSeed = AlignedBuffer::alignDown(max(0LL, options.cloneSeed));
+        #ifdef _WIN32
+        options.cloneSeed = 0;
+        #endif
+        if (options.cloneSeed >= fileSize || options.allocateOnly) options.cloneSeed = 0;
+        
+        // A stream has no file behind it to sync, allocate, checkpoint or read back
+        if (options.stream) {
+            options.cloneSeed = 0;
+            options.sync = SyncMode::None;
+            options.directIO = false;
+            options.allocateOnly = false;
+            options.verifyAfterWrite = false;
+            options.checkpointPath.clear();
+            options.resume = false;
+            options.stripeTargets.clear();
+        }
+        limiter.configure(options.rateLimit, static_cast<double>(options.rateBurst), options.rateRamp, options.rateProfile);
+        // Paced writes are cut to the burst (whole 4 KB blocks, so direct I/O stays aligned)
+        if (limiter.enabled()) {
+            pacedSlice = static_cast<size_t>(max(static_cast<long long>(AlignedBuffer::ALIGNMENT),
+                                                 AlignedBuffer::alignDown(static_cast<long long>(limiter.burst()))));
+        }
+        options.dedupBlock = max(static_cast<long long>(PatternGenerator::BLOCK), AlignedBuffer::alignDown(options.dedupBlock));
+        if (useRandomData) generator.shape(options.compressRatio, options.dedupRatio, static_cast<size_t>(options.dedupBlock));
+    }
+
+    ~TurboFileCreator() {
+        stopMetrics();
+    }
+
+    bool execute() {
+        if (options.stream) return executeStream();
+        
+        // Fall back to the portable stream path when io_uring is unavailable
+        bool uringFallback = false;
+        if (options.backend == WriteBackend::IoUring) {
+            #ifdef TURBO_HAVE_IO_URING
+            uringFallback = !UringQueue::isSupported();
+            #else
+            uringFallback = true;
+            #endif
+            if (uringFallback) options.backend = WriteBackend::Stream;
+        }
+        
+        #ifdef _WIN32
+        bool mmapFallback = options.backend == WriteBackend::Mmap;
+        if (mmapFallback) options.backend = WriteBackend::Stream;
+        #else
+        bool mmapFallback = false;
+        #endif
+        
+        restrictCpus();
+        if (view()) view()->configured(*this);
+        reportPlacement();
+        MetricsSession metrics(*this);
+        
+        if (uringFallback) {
+            reportWarning("io_uring is not available here, using the ofstream engine instead");
+        }
+        if (mmapFallback) {
+            reportWarning("The mmap engine is not available here, using the ofstream engine instead");
+        }
+        // io_uring keeps its concurrency in the queue depth, and a stripe set runs one group per target
+        if (options.adaptive && (options.backend == WriteBackend::IoUring || !options.stripeTargets.empty())) {
+            reportWarning("Adaptive concurrency applies to the ofstream, direct and mmap engines on one target, using a fixed count");
+            options.adaptive = false;
+        }
+        // Stripe members run side by side, each from its own offsets: no single seed or unit bitmap
+        if (!options.stripeTargets.empty() && (options.cloneSeed > 0 || !options.checkpointPath.empty())) {
+            reportWarning("Clone mode and checkpoints do not apply to striped output, writing without them");
+            options.cloneSeed = 0;
+            options.checkpointPath.clear();
+            options.resume = false;
+        }
+        // Clones are not tracked per unit, so a checkpoint could not say what is left
+        if (options.cloneSeed > 0 && !options.checkpointPath.empty()) {
+            reportWarning("Checkpoints do not apply to clone mode, writing without one");
+            options.checkpointPath.clear();
+            options.resume = false;
+        }
+        // Mappings always go through the page cache
+        if (options.directIO && options.backend == WriteBackend::Mmap) {
+            reportWarning("Direct I/O does not apply to the mmap engine, writing through the page cache");
+            options.directIO = false;
+        }
+        
+        if (view()) view()->initializing(*this);
+        if (!options.stripeTargets.empty()) return executeStriped();
+
+        if (!options.checkpointPath.empty() && !prepareCheckpoint()) return false;
+        
+        // Pre-allocate file; a resumed file keeps its extents and the data already in them
+        auto allocStart = steady_clock::now();
+        if (options.resume) {
+            preallocMethod = "kept (resume)";
+        } else if (!preallocate()) {
+            reportError("Cannot create file");
+            return false;
+        }
+        preallocTime = duration<double>(steady_clock::now() - allocStart).count();
+        
+        // Metadata-only fast path: the allocated extents already read back as zeroes
+        if (options.allocateOnly) {
+            if (options.prealloc == PreallocMode::None) {
+                reportWarning("--prealloc=none reserves no blocks, the file is only sparse");
+            } else if (preallocMethod.compare(0, 6, "sparse") == 0) {
+                reportWarning("Filesystem cannot reserve blocks, the file is only sparse");
+            }
+            bytesWritten = fileSize;
+            trackProgress(fileSize, fileSize, preallocTime);
+            reportSummary(preallocTime);
+            return true;
+        }
+
+        // Not every filesystem (tmpfs, some FUSE mounts) accepts O_DIRECT
+        if (options.directIO) {
+            #ifdef _WIN32
+            bool directSupported = false;
+            #else
+            int probe = openTarget(true);
+            bool directSupported = probe >= 0;
+            if (directSupported) close(probe);
+            #endif
+            if (!directSupported) {
+                reportWarning("Direct I/O is not supported for this target, writing through the page cache");
+                options.directIO = false;
+            }
+        }
+
+        if (view()) view()->running(*this);
+
+        auto startTime = steady_clock::now();
+
+        // Launch workers
+        prepareSharedBuffers();
+        limiter.start();
+        vector<thread> workers;
+        int writers = writerCount();
+        workerStatsCount = writers;
+        workerStats.reset(new WorkerStats[writers]);
+        if (options.adaptive) {
+            controller.start(writers);
+            writerLimit = controller.writers();
+        }
+        if (checkpoint.active()) {
+            scheduler.reset(fileSize, checkpoint.unit(), options.resume ? &skipUnits : nullptr);
+        } else if (options.cloneSeed > 0) {
+            // The writers only produce the seed; the clone stage covers the rest in seed-sized units
+            scheduler.reset(options.cloneSeed, chunkUnit(options.cloneSeed, writers));
+            cloneScheduler.reset(fileSize - options.cloneSeed, options.cloneSeed);
+            seedWriters = writers;
+        } else {
+            scheduler.reset(fileSize, chunkUnit(fileSize, writers));
+        }
+        
+        for (int i = 0; i < writers; i++) {
+            void (TurboFileCreator::*writer)(int) = &TurboFileCreator::turboWriter;
+            #ifdef TURBO_HAVE_IO_URING
+            if (options.backend == WriteBackend::IoUring) writer = &TurboFileCreator::uringWriter;
+            #endif
+            #ifndef _WIN32
+            if (options.backend == WriteBackend::Mmap) writer = &TurboFileCreator::mmapWriter;
+            else if (options.directIO && options.backend != WriteBackend::IoUring) writer = &TurboFileCreator::directWriter;
+            
+            if (options.cloneSeed > 0) {
+                workers.emplace_back(&TurboFileCreator::seedThenClone, this, writer, i);
+                continue;
+            }
+            #endif
+            workers.emplace_back(writer, this, i);
+        }
+
+        // Monitor progress
+        double nextReport = options.progressInterval;
+        checkpointStop = false;
+        if (checkpoint.active()) checkpointSaver = thread(&TurboFileCreator::saveCheckpoints, this);
+        while (bytesWritten + resumedBytes < fileSize && !errorFlag) {
+            this_thread::sleep_for(milliseconds(50));
+            
+            auto now = steady_clock::now();
+            double elapsed = duration<double>(now - startTime).count();
+            
+            trackProgress(bytesWritten.load() + resumedBytes, fileSize, elapsed);
+            
+            if (headless() && options.progressInterval > 0 && elapsed >= nextReport) {
+                emitProgressRecord(bytesWritten.load() + resumedBytes, elapsed);
+                nextReport += options.progressInterval;
+            }
+            
+            ConcurrencyController::Decision decision;
+            if (options.adaptive && controller.sample(elapsed, bytesWritten.load(), decision)) {
+                writerLimit = decision.to;
+                logDecision(decision);
+            }
+        }
+
+        // Wait for workers
+        for (auto& worker : workers) {
+            if (worker.joinable()) worker.join();
+        }
+        checkpointStop = true;
+        if (checkpointSaver.joinable()) checkpointSaver.join();
+
+        auto endTime = steady_clock::now();
+        double totalTime = duration<double>(endTime - startTime).count();
+        writeTime = totalTime;
+
+        if (view()) view()->stopped(*this);
+        reportPlacement();
+
+        if (errorFlag) {
+            reportError(failureReason("Write operation failed"));
+            if (checkpoint.active() && saveCheckpoint()) {
+                reportWarning("Checkpoint saved to '" + checkpoint.location() + "' (" + formatBytes(checkpoint.doneBytes()) + " of "
+                              + formatBytes(fileSize) + " done), rerun with --resume to continue");
+            }
+            return false;
+        }
+
+        #ifndef _WIN32
+        if (options.sync != SyncMode::None) flushTime = flushToDevice();
+        #endif
+        if (checkpoint.active()) checkpoint.discard();
+
+        // Final progress
+        trackProgress(fileSize, fileSize, totalTime);
+        reportSummary(totalTime);
+        
+        if (options.verifyAfterWrite) {
+            return verify();
+        }
+        return true;
+    }
+
+    // Striped output: one quiet creator and worker group per target, summed by this monitor
+    bool executeStriped() {
+        vector<string> targets(1, fileName);
+        targets.insert(targets.end(), options.stripeTargets.begin(), options.stripeTargets.end());
+        int width = stripeWidth();
+        
+        for (int t = 0; t < width; t++) {
+            CreatorOptions member = options;
+            member.quiet = true;
+            member.verifyAfterWrite = false;
+            member.stripeTargets.clear();
+            member.metricsFile.clear();
+            member.metricsListen.clear();
+            member.stripeIndex = t;
+            member.stripeCount = width;
+            // Each group starts on its own CPUs, and takes its share of a rate limit
+            if (!member.cpus.empty()) {
+                rotate(member.cpus.begin(), member.cpus.begin() + (t * stripeThreads()) % member.cpus.size(), member.cpus.end());
+            }
+            member.rateLimit /= width;
+            member.rateBurst /= width;
+            for (auto& step : member.rateProfile) step.bytesPerSec /= width;
+            
+            unique_ptr<StripeMember> stripe(new StripeMember());
+            stripe->creator.reset(new TurboFileCreator(targets[t], stripeShare(fileSize, options.stripeUnit, width, t),
+                                                       stripeThreads(), bufferSizeMB, useRandomData, false, member));
+            stripes.push_back(move(stripe));
+        }
+        
+        if (view()) view()->running(*this);
+        limiter.start();
+        auto startTime = steady_clock::now();
+        for (auto& stripe : stripes) {
+            StripeMember* member = stripe.get();
+            member->runner = thread([this, member, startTime] {
+                member->succeeded = member->creator->execute();
+                member->finishedAt = duration<double>(steady_clock::now() - startTime).count();
+                member->finished = true;
+                if (!member->succeeded) errorFlag = true;
+            });
+        }
+        
+        // Monitor progress; a failed member stops the others
+        double nextReport = options.progressInterval;
+        bool done = false;
+        while (!done) {
+            this_thread::sleep_for(milliseconds(50));
+            double elapsed = duration<double>(steady_clock::now() - startTime).count();
+            
+            long long written = 0;
+            int active = 0;
+            done = true;
+            for (auto& stripe : stripes) {
+                written += stripe->creator->bytesWritten.load();
+                active += stripe->creator->activeWorkers.load();
+                done = done && stripe->finished;
+                if (errorFlag && !stripe->finished && !stripe->cancelled) {
+                    stripe->cancelled = true;
+                    stripe->creator->cancel();
+                }
+            }
+            bytesWritten = written;
+            activeWorkers = active;
+            trackProgress(written, fileSize, elapsed);
+            
+            if (headless() && options.progressInterval > 0 && elapsed >= nextReport) {
+                emitProgressRecord(written, elapsed);
+                nextReport += options.progressInterval;
+            }
+        }
+        for (auto& stripe : stripes) stripe->runner.join();
+        
+        // The set is done when its last member is; that member's flush is the set's closing flush
+        StripeMember* last = stripes.front().get();
+        for (auto& stripe : stripes) {
+            if (stripe->finishedAt > last->finishedAt) last = stripe.get();
+        }
+        flushTime = last->creator->flushTime;
+        double totalTime = max(0.0, last->finishedAt - flushTime);
+        writeTime = totalTime;
+        if (view()) view()->stopped(*this);
+        absorbStripes();
+        
+        if (errorFlag) {
+            if (cancelRequested) reportError(failureReason(""));
+            for (auto& stripe : stripes) {
+                if (!stripe->succeeded && !stripe->cancelled) reportError("Write to '" + stripe->creator->fileName + "' failed");
+            }
+            if (headless()) emitStripeRecords();
+            return false;
+        }
+        
+        // Read back every member in parallel once all of them are on disk
+        bool passed = true;
+        if (options.verifyAfterWrite) {
+            if (view()) view()->verifying(*this);
+            vector<thread> verifiers;
+            for (auto& stripe : stripes) {
+                StripeMember* member = stripe.get();
+                verifiers.emplace_back([member] { member->verified = member->creator->verify(); });
+            }
+            for (auto& verifier : verifiers) verifier.join();
+            for (auto& stripe : stripes) {
+                if (!stripe->verified) {
+                    reportError("Verification of '" + stripe->creator->fileName + "' failed");
+                    passed = false;
+                }
+            }
+        }
+        
+        trackProgress(fileSize, fileSize, totalTime);
+        if (headless()) emitStripeRecords();
+        reportSummary(totalTime);
+        return passed;
+    }
+
+    // Standalone verification of an existing file
+    bool verifyExisting() {
+        if (view()) view()->verifyConfigured(*this);
+        return verify();
+    }
+
+    // fio-style mixed workload against an existing file, until the duration or op count is reached
+    bool executeWorkload();
+
+    // Streams the pattern to stdout or a FIFO; an unbounded stream ends when the reader leaves
+    bool executeStream() {
+        // Zero-copy only hands the kernel buffers that stay unchanged while it holds them (see streamWriter)
+        string error;
+        bool stable = !useRandomData;
+        if (!sink.open(fileName, static_cast<size_t>(bufferSizeMB) * 1024 * 1024, !options.streamCopy && (stable || pipelined()),
+                       !options.streamCopy && stable, error)) {
+            reportError(error);
+            sink.close();
+            return false;
+        }
+        
+        restrictCpus();
+        if (view()) view()->configured(*this);
+        reportPlacement();
+        MetricsSession metrics(*this);
+        if (view()) view()->running(*this);
+        
+        preallocMethod = "none (stream)";
+        prepareSharedBuffers();
+        limiter.start();
+        workerStatsCount = 1;
+        workerStats.reset(new WorkerStats[1]);
+        long long total = options.unbounded ? LLONG_MAX / 4 : fileSize;
+        scheduler.reset(total, chunkUnit(total, 1));
+        
+        auto startTime = steady_clock::now();
+        thread writer(&TurboFileCreator::streamWriter, this, 0);
+        
+        double nextReport = options.progressInterval;
+        while ((options.unbounded || bytesWritten < fileSize) && !errorFlag) {
+            this_thread::sleep_for(milliseconds(50));
+            double elapsed = duration<double>(steady_clock::now() - startTime).count();
+            
+            trackProgress(bytesWritten.load(), options.unbounded ? 0 : fileSize, elapsed);
+            
+            if (headless() && options.progressInterval > 0 && elapsed >= nextReport) {
+                emitProgressRecord(bytesWritten.load(), elapsed);
+                nextReport += options.progressInterval;
+            }
+        }
+        
+        writer.join();
+        sink.close();
+        
+        double totalTime = duration<double>(steady_clock::now() - startTime).count();
+        writeTime = totalTime;
+        if (view()) view()->stopped(*this);
+        reportPlacement();
+        
+        // An unbounded stream only ends when the reader or the caller stops it
+        if (errorFlag && !((sink.ended() || cancelRequested) && options.unbounded)) {
+            reportError(sink.ended() ? "Reader closed the stream after " + formatBytes(bytesWritten.load()) : failureReason("Stream write failed"));
+            return false;
+        }
+        
+        // The stream's size is whatever the reader took
+        if (options.unbounded) {
+            fileSize = bytesWritten.load();
+            progressTotal = fileSize;
+        }
+        trackProgress(fileSize, fileSize, totalTime);
+        reportSummary(totalTime);
+        return true;
+    }
+
+    // Creates every file of the plan; fileName is the tree root and fileSize the plan's total bytes
+    bool executeBatch(const BatchPlan& plan);
+
+    // Write throughput including the final flush, i.e. what the device sustained
+    double deviceThroughput() const {
+        return committedSpeed(writeTime);
+    }
+
+    // Live counters, safe to read from any thread: `done` includes resumed bytes, workloads count `ops`
+    struct Progress {
+        long long done = 0;
+        long long total = 0;
+        long long verified = 0;
+        long long ops = 0;
+        int activeWorkers = 0;
+    };
+
+    Progress progress() const {
+        Progress snapshot;
+        snapshot.done = bytesWritten.load() + resumedBytes.load();
+        snapshot.total = progressTotal.load();
+        snapshot.verified = bytesVerified.load();
+        snapshot.ops = opsIssued.load();
+        snapshot.activeWorkers = activeWorkers.load();
+        return snapshot;
+    }
+
+    // Stops the run from any thread; it then fails with "Cancelled", except an unbounded stream
+    void cancel() {
+        cancelRequested = true;
+        errorFlag = true;
+        workloadStop = true;
+        limiter.abort();
+    }
+
+    bool cancelled() const { return cancelRequested; }
+    const string& lastError() const { return failure; }
+};
+
+// Embedding API
+// A Job runs one creator on its own thread; the result comes through a future and an optional callback
+enum class JobKind {
+    Create,
+    Verify,     // Read back an existing file
+    Workload,   // Mixed I/O against an existing file
+    Batch       // The files in JobSpec::batch, under path
+};
+
+struct JobSpec {
+    JobKind kind = JobKind::Create;
+    string path;
+    long long size = 0;     // Verify and workload default to the size on disk
+    int threads = 4;
+    int bufferMB = 32;
+    bool randomData = false;
+    bool turbo = true;
+    CreatorOptions options;
+    BatchPlan batch;
+
+    JobSpec() { options.quiet = true; }
+};
+
+struct JobResult {
+    bool succeeded = false;
+    bool cancelled = false;
+    string error;
+    long long bytes = 0;    // Written, or read back for a verify job
+    double seconds = 0;
+};
+
+struct JobSnapshot {
+    TurboFileCreator::Progress progress;
+    double elapsed = 0;
+    double bytesPerSec = 0;
+    bool finished = false;
+    bool cancelled = false;
+};
+
+class Job {
+public:
+    typedef function<void(const JobResult&)> Callback;
+
+private:
+    JobSpec spec;
+    unique_ptr<TurboFileCreator> creator;
+    string setupError;
+    Callback onDone;
+    promise<JobResult> outcome;
+    shared_future<JobResult> future;
+    steady_clock::time_point startTime;
+    atomic<bool> done{false};
+    thread runner;
+
+    Job(const JobSpec& jobSpec, const Callback& callback)
+        : spec(jobSpec), onDone(callback), future(outcome.get_future().share()), startTime(steady_clock::now()) {}
+
+    void run() {
+        JobResult result;
+        if (creator) {
+            switch (spec.kind) {
+                case JobKind::Verify: result.succeeded = creator->verifyExisting(); break;
+                case JobKind::Workload: result.succeeded = creator->executeWorkload(); break;
+                case JobKind::Batch: result.succeeded = creator->executeBatch(spec.batch); break;
+                default: result.succeeded = creator->execute(); break;
+            }
+            TurboFileCreator::Progress progress = creator->progress();
+            result.cancelled = creator->cancelled();
+            result.error = creator->lastError();
+            result.bytes = spec.kind == JobKind::Verify ? progress.verified : progress.done;
+        } else {
+            result.error = setupError;
+        }
+        if (!result.succeeded && result.error.empty()) result.error = result.cancelled ? "Cancelled" : "Operation failed";
+        result.seconds = duration<double>(steady_clock::now() - startTime).count();
+        
+        done = true;
+        outcome.set_value(result);
+        if (onDone) onDone(result);
+    }
+
+public:
+    // The creator exists before the thread starts; a spec that cannot run completes at once with its error
+    static unique_ptr<Job> submit(const JobSpec& spec, const Callback& onDone = Callback()) {
+        unique_ptr<Job> job(new Job(spec, onDone));
+        long long size = spec.kind == JobKind::Batch ? spec.batch.totalBytes() : spec.size;
+        
+        if (size <= 0 && (spec.kind == JobKind::Verify || spec.kind == JobKind::Workload)) {
+            ifstream existing(spec.path, ios::binary | ios::ate);
+            if (existing) size = static_cast<long long>(existing.tellg());
+            else job->setupError = "Cannot open '" + spec.path + "'";
+        } else if (size <= 0 && spec.kind == JobKind::Create && !spec.options.unbounded) {
+            job->setupError = "Invalid size";
+        }
+        if (job->setupError.empty()) {
+            job->creator.reset(new TurboFileCreator(spec.path, size, spec.threads, spec.bufferMB, spec.randomData, spec.turbo, spec.options));
+        }
+        job->runner = thread(&Job::run, job.get());
+        return job;
+    }
+
+    ~Job() {
+        cancel();
+        if (runner.joinable()) runner.join();
+    }
+
+    shared_future<JobResult> result() const { return future; }
+    bool finished() const { return done; }
+
+    JobSnapshot snapshot() const {
+        JobSnapshot snap;
+        if (creator) snap.progress = creator->progress();
+        snap.elapsed = duration<double>(steady_clock::now() - startTime).count();
+        snap.bytesPerSec = snap.elapsed > 0 ? snap.progress.done / snap.elapsed : 0;
+        snap.finished = done;
+        snap.cancelled = creator && creator->cancelled();
+        return snap;
+    }
+
+    // Returns at once; the run stops within about one block per writer and then completes normally
+    void cancel() {
+        if (creator) creator->cancel();
+    }
+};
+
+} // namespace turbo
+
+// The batch and workload runs of TurboFileCreator
+#include "file_creator_batch.hpp"
+#include "file_creator_workload.hpp"
+
+#endif // TURBO_FILE_CREATOR_ENGINE_HPP
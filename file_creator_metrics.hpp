@@ -0,0 +1,182 @@
+// Turbo File Creator metrics export
+// Serves the latest Prometheus page over HTTP and mirrors it to a textfile
+#ifndef TURBO_FILE_CREATOR_METRICS_HPP
+#define TURBO_FILE_CREATOR_METRICS_HPP
+
+#include <string>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cstdint>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#endif
+
+namespace turbo {
+
+using namespace std;
+
+// The monitor hands each page over under a lock the writers never touch
+class MetricsServer {
+    string page;
+    mutex pageLock;
+    thread server;
+    atomic<bool> stopping{false};
+    int listener = -1;
+    string address;
+
+    #ifndef _WIN32
+    // Binds "[HOST:]PORT" (loopback unless a host is given) or "unix:PATH"
+    static int bindAddress(const string& address) {
+        int fd = -1;
+        if (address.compare(0, 5, "unix:") == 0) {
+            sockaddr_un local;
+            memset(&local, 0, sizeof(local));
+            local.sun_family = AF_UNIX;
+            string path = address.substr(5);
+            if (path.empty() || path.size() >= sizeof(local.sun_path)) return -1;
+            strcpy(local.sun_path, path.c_str());
+            // Only a stale socket is replaced; any other file at the path makes bind() fail
+            struct stat existing;
+            if (lstat(path.c_str(), &existing) == 0 && S_ISSOCK(existing.st_mode)) unlink(path.c_str());
+            fd = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (fd >= 0 && bind(fd, reinterpret_cast<sockaddr*>(&local), sizeof(local)) != 0) {
+                close(fd);
+                fd = -1;
+            }
+        } else {
+            size_t colon = address.rfind(':');
+            string host = colon == string::npos ? "127.0.0.1" : address.substr(0, colon);
+            int port = atoi(address.substr(colon == string::npos ? 0 : colon + 1).c_str());
+            sockaddr_in inet;
+            memset(&inet, 0, sizeof(inet));
+            inet.sin_family = AF_INET;
+            inet.sin_port = htons(static_cast<uint16_t>(port));
+            if (port <= 0 || port > 65535 || inet_pton(AF_INET, host == "localhost" ? "127.0.0.1" : host.c_str(), &inet.sin_addr) != 1) return -1;
+            fd = socket(AF_INET, SOCK_STREAM, 0);
+            int reuse = 1;
+            if (fd >= 0) setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+            if (fd >= 0 && bind(fd, reinterpret_cast<sockaddr*>(&inet), sizeof(inet)) != 0) {
+                close(fd);
+                fd = -1;
+            }
+        }
+        if (fd >= 0 && ::listen(fd, 16) != 0) {
+            close(fd);
+            fd = -1;
+        }
+        return fd;
+    }
+
+    // Answers every request, whatever its path, with the latest page; one short connection at a time
+    void serve() {
+        while (!stopping) {
+            pollfd ready = {listener, POLLIN, 0};
+            if (poll(&ready, 1, 200) <= 0) continue;
+            int client = accept(listener, nullptr, nullptr);
+            if (client < 0) continue;
+
+            timeval timeout = {1, 0};
+            setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+            #ifdef SO_NOSIGPIPE
+            int noSignal = 1;
+            setsockopt(client, SOL_SOCKET, SO_NOSIGPIPE, &noSignal, sizeof(noSignal));
+            #endif
+            char request[2048];
+            if (recv(client, request, sizeof(request), 0) > 0) {
+                string body;
+                {
+                    lock_guard<mutex> guard(pageLock);
+                    body = page;
+                }
+                string response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: "
+                                  + to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+                int flags = 0;
+                #ifdef MSG_NOSIGNAL
+                flags = MSG_NOSIGNAL;
+                #endif
+                size_t sent = 0;
+                while (sent < response.size()) {
+                    ssize_t n = send(client, response.data() + sent, response.size() - sent, flags);
+                    if (n <= 0) break;
+                    sent += static_cast<size_t>(n);
+                }
+            }
+            close(client);
+        }
+    }
+    #endif
+
+public:
+    MetricsServer() {}
+    MetricsServer(const MetricsServer&) = delete;
+    MetricsServer& operator=(const MetricsServer&) = delete;
+    ~MetricsServer() { stop(); }
+
+    // Starts answering on `where`; on failure `error` says why
+    bool listen(const string& where, string& error) {
+        #ifdef _WIN32
+        (void)where;
+        error = "The metrics endpoint is not available here, exporting to the metrics file only";
+        return false;
+        #else
+        listener = bindAddress(where);
+        if (listener < 0) {
+            error = "Cannot listen on '" + where + "' for metrics: " + strerror(errno);
+            return false;
+        }
+        address = where;
+        stopping = false;
+        server = thread(&MetricsServer::serve, this);
+        return true;
+        #endif
+    }
+
+    void publish(string next) {
+        lock_guard<mutex> guard(pageLock);
+        page.swap(next);
+    }
+
+    // Closes the endpoint, removing its socket file
+    void stop() {
+        stopping = true;
+        if (server.joinable()) server.join();
+        #ifndef _WIN32
+        if (listener >= 0) {
+            close(listener);
+            if (address.compare(0, 5, "unix:") == 0) unlink(address.substr(5).c_str());
+        }
+        #endif
+        listener = -1;
+        address.clear();
+    }
+
+    // Writes through a rename, so a textfile collector never reads half a page
+    static bool writeFile(const string& path, const string& content) {
+        string temp = path + ".tmp";
+        ofstream out(temp, ios::trunc);
+        out << content;
+        out.close();
+        #ifdef _WIN32
+        remove(path.c_str());
+        #endif
+        return out && rename(temp.c_str(), path.c_str()) == 0;
+    }
+};
+
+} // namespace turbo
+
+#endif // TURBO_FILE_CREATOR_METRICS_HPP
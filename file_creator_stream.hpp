@@ -0,0 +1,169 @@
+// Turbo File Creator stream sink
+// Where a streamed run's blocks go: stdout, a FIFO or a socket
+#ifndef TURBO_FILE_CREATOR_STREAM_HPP
+#define TURBO_FILE_CREATOR_STREAM_HPP
+
+#include <string>
+#include <atomic>
+#include <algorithm>
+#include <cstdio>
+#include <cerrno>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+#endif
+
+namespace turbo {
+
+using namespace std;
+
+// Pipes take the buffers through vmsplice, sockets through a relay pipe and splice
+class StreamSink {
+public:
+    enum class Path { Write, Vmsplice, Relay };
+
+private:
+    Path route = Path::Write;
+    int fd = -1;
+    int relay[2] = {-1, -1};
+    long long pipeCapacity = 0;
+    atomic<bool> readerGone{false};
+
+    // Largest power of two within one buffer, so a finished vmsplice proves the previous buffer left the pipe
+    static long long sizePipe(int pipeFd, size_t bufferBytes) {
+        #ifdef F_SETPIPE_SZ
+        long long want = 1LL << 16;
+        while (want * 2 <= static_cast<long long>(bufferBytes)) want *= 2;
+        while (want > (1LL << 16) && fcntl(pipeFd, F_SETPIPE_SZ, static_cast<int>(want)) < 0) want /= 2;
+        return fcntl(pipeFd, F_GETPIPE_SZ);
+        #else
+        (void)pipeFd;
+        (void)bufferBytes;
+        return 0;
+        #endif
+    }
+
+    // A reader that goes away shows up as EPIPE
+    bool failed() {
+        if (errno == EPIPE) readerGone = true;
+        return false;
+    }
+
+public:
+    StreamSink() {}
+    StreamSink(const StreamSink&) = delete;
+    StreamSink& operator=(const StreamSink&) = delete;
+    ~StreamSink() { close(); }
+
+    // "-" is stdout, else a FIFO (waits for a reader) or socket; the splice flags allow zero-copy to each
+    bool open(const string& name, size_t bufferBytes, bool splicePipe, bool spliceSocket, string& error) {
+        #ifdef _WIN32
+        (void)bufferBytes;
+        (void)splicePipe;
+        (void)spliceSocket;
+        if (name != "-") {
+            error = "Only stdout can be streamed to on Windows";
+            return false;
+        }
+        fd = _fileno(stdout);
+        _setmode(fd, _O_BINARY);
+        return true;
+        #else
+        fd = name == "-" ? STDOUT_FILENO : ::open(name.c_str(), O_WRONLY);
+        struct stat info;
+        if (fd < 0 || fstat(fd, &info) != 0) {
+            error = "Cannot open '" + (name == "-" ? string("stdout") : name) + "' for streaming";
+            return false;
+        }
+        if (isatty(fd)) {
+            error = "Refusing to stream binary data to a terminal";
+            return false;
+        }
+
+        #ifdef __linux__
+        if (S_ISFIFO(info.st_mode) && splicePipe) {
+            route = Path::Vmsplice;
+            pipeCapacity = sizePipe(fd, bufferBytes);
+        } else if (S_ISSOCK(info.st_mode) && spliceSocket && pipe(relay) == 0) {
+            route = Path::Relay;
+            pipeCapacity = sizePipe(relay[1], bufferBytes);
+        }
+        #else
+        (void)bufferBytes;
+        (void)splicePipe;
+        (void)spliceSocket;
+        #endif
+        return true;
+        #endif
+    }
+
+    bool write(const char* data, size_t length) {
+        #ifdef __linux__
+        if (route != Path::Write) {
+            int target = route == Path::Vmsplice ? fd : relay[1];
+            while (length > 0) {
+                size_t piece = route == Path::Relay ? min(length, static_cast<size_t>(pipeCapacity)) : length;
+                struct iovec iov = {const_cast<char*>(data), piece};
+                ssize_t moved = vmsplice(target, &iov, 1, 0);
+                if (moved < 0 && errno == EINTR) continue;
+                if (moved <= 0) return failed();
+
+                // Drain the relay into the socket before mapping more
+                for (ssize_t left = route == Path::Relay ? moved : 0; left > 0; ) {
+                    ssize_t sent = splice(relay[0], nullptr, fd, nullptr, static_cast<size_t>(left), SPLICE_F_MOVE | SPLICE_F_MORE);
+                    if (sent < 0 && errno == EINTR) continue;
+                    if (sent <= 0) return failed();
+                    left -= sent;
+                }
+                data += moved;
+                length -= static_cast<size_t>(moved);
+            }
+            return true;
+        }
+        #endif
+
+        while (length > 0) {
+            #ifdef _WIN32
+            int chunk = static_cast<int>(min(length, static_cast<size_t>(1) << 30));
+            int written = _write(fd, data, chunk);
+            if (written <= 0) return false;
+            #else
+            ssize_t written = ::write(fd, data, length);
+            if (written < 0 && errno == EINTR) continue;
+            if (written <= 0) return failed();
+            #endif
+            data += written;
+            length -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    void close() {
+        #ifndef _WIN32
+        if (fd >= 0 && fd != STDOUT_FILENO) ::close(fd);
+        if (relay[0] >= 0) ::close(relay[0]);
+        if (relay[1] >= 0) ::close(relay[1]);
+        #endif
+        fd = relay[0] = relay[1] = -1;
+    }
+
+    Path path() const { return route; }
+
+    const char* pathName() const {
+        static const char* names[] = {"write, copied", "vmsplice, zero-copy", "vmsplice + splice, zero-copy"};
+        return names[static_cast<int>(route)];
+    }
+
+    // True once a write failed because the reader closed its end
+    bool ended() const { return readerGone; }
+};
+
+} // namespace turbo
+
+#endif // TURBO_FILE_CREATOR_STREAM_HPP
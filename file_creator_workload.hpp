@@ -0,0 +1,213 @@
+// Turbo File Creator workload mode
+// fio-style mixed reads and writes against an existing file; file_creator_engine.hpp includes it
+#ifndef TURBO_FILE_CREATOR_WORKLOAD_HPP
+#define TURBO_FILE_CREATOR_WORKLOAD_HPP
+
+#include "file_creator_engine.hpp"
+
+namespace turbo {
+
+#ifndef _WIN32
+// Issues blockSize reads and writes; writes carry the pattern, so the file still passes `verify`
+inline void TurboFileCreator::workloadWorker(int threadID) {
+    activeWorkers++;
+    placeWorker(threadID);
+    int fd = -1;
+    
+    try {
+        size_t bs = static_cast<size_t>(options.blockSize);
+        int flags = options.readPercent >= 100 ? O_RDONLY : O_RDWR;
+        #ifdef O_DIRECT
+        if (options.directIO) flags |= O_DIRECT;
+        #endif
+        fd = open(fileName.c_str(), flags);
+        if (fd < 0) {
+            errorFlag = true;
+            activeWorkers--;
+            return;
+        }
+        #if !defined(O_DIRECT) && defined(F_NOCACHE)
+        if (options.directIO) fcntl(fd, F_NOCACHE, 1);
+        #endif
+        
+        AlignedBuffer readBuffer(bs);
+        AlignedBuffer writeBuffer(bs);
+        memset(writeBuffer.data(), 0, bs);
+        OffsetPicker picker(options.distribution, fileSize / options.blockSize, threadID, workerStatsCount,
+                            generator.seedValue(), &zipfTable);
+        WorkerStats& mine = workerStats[threadID];
+        
+        while (!errorFlag && !workloadStop) {
+            long long issued = opsIssued.fetch_add(1, memory_order_relaxed);
+            if (options.opLimit > 0 && issued >= options.opLimit) break;
+            
+            long long offset = picker.next() * options.blockSize;
+            bool isRead = picker.uniform() * 100 < options.readPercent;
+            if (!isRead) fillPattern(writeBuffer.data(), bs, offset);
+            limiter.acquire(options.blockSize);
+            
+            auto opStart = steady_clock::now();
+            bool ok = isRead ? preadFull(fd, readBuffer.data(), bs, offset) == options.blockSize
+                             : pwriteAll(fd, writeBuffer.data(), bs, offset);
+            if (!ok) {
+                errorFlag = true;
+                break;
+            }
+            
+            auto nanos = static_cast<uint64_t>(duration_cast<nanoseconds>(steady_clock::now() - opStart).count());
+            if (isRead) {
+                mine.readLatency.record(nanos);
+                mine.readBytes += options.blockSize;
+                stats.operationCount++;
+            } else {
+                mine.writeLatency.record(nanos);
+                recordWrite(threadID, options.blockSize);
+            }
+        }
+    } catch (...) {
+        errorFlag = true;
+    }
+    
+    if (fd >= 0) close(fd);
+    activeWorkers--;
+}
+#endif
+
+inline string TurboFileCreator::distributionName(OffsetDistribution distribution, double theta) {
+    switch (distribution) {
+        case OffsetDistribution::Sequential: return "sequential";
+        case OffsetDistribution::Zipf: {
+            stringstream ss;
+            ss << "zipf:" << theta;
+            return ss.str();
+        }
+        default: return "random";
+    }
+}
+
+inline void TurboFileCreator::trackWorkload(long long reads, long long writes, double elapsed, double limit) {
+    stats.recordSpeed(elapsed > 0 ? (reads + writes) * static_cast<double>(options.blockSize) / elapsed : 0);
+    if (view()) view()->workloadProgress(*this, reads, writes, elapsed, limit);
+}
+
+inline void TurboFileCreator::workloadTotals(LatencyHistogram& reads, LatencyHistogram& writes, long long& readBytes, long long& writeBytes) const {
+    readBytes = writeBytes = 0;
+    for (int i = 0; i < workerStatsCount; i++) {
+        reads.merge(workerStats[i].readLatency);
+        writes.merge(workerStats[i].writeLatency);
+        readBytes += workerStats[i].readBytes.load();
+        writeBytes += workerStats[i].bytes.load();
+    }
+}
+
+inline void TurboFileCreator::addOpFields(StructuredRecord& record, const string& prefix, const LatencyHistogram& latency, long long bytes, double totalTime) {
+    record.addInt(prefix + "_ops", static_cast<long long>(latency.count()))
+          .addNumber(prefix + "_iops", totalTime > 0 ? latency.count() / totalTime : 0, 1)
+          .addNumber(prefix + "_bps", totalTime > 0 ? bytes / totalTime : 0, 0)
+          .addInt(prefix + "_mean_ns", latency.count() > 0 ? static_cast<long long>(latency.sum() / latency.count()) : 0)
+          .addInt(prefix + "_p50_ns", static_cast<long long>(latency.percentile(50)))
+          .addInt(prefix + "_p99_ns", static_cast<long long>(latency.percentile(99)))
+          .addInt(prefix + "_p999_ns", static_cast<long long>(latency.percentile(99.9)))
+          .addInt(prefix + "_max_ns", static_cast<long long>(latency.maximum()));
+}
+
+inline bool TurboFileCreator::executeWorkload() {
+    #ifdef _WIN32
+    reportError("Workload mode is not supported on this platform");
+    return false;
+    #else
+    if (options.blockSize <= 0 || fileSize < options.blockSize) {
+        reportError("Block size must be between 1 byte and the file size");
+        return false;
+    }
+    if (options.directIO && options.blockSize % AlignedBuffer::ALIGNMENT != 0) {
+        reportError("Direct I/O needs a block size that is a multiple of 4 KB");
+        return false;
+    }
+    if (options.distribution == OffsetDistribution::Zipf && fabs(options.zipfTheta - 1.0) < 1e-9) {
+        reportError("Zipf theta must not be 1.0");
+        return false;
+    }
+    double limit = options.duration > 0 || options.opLimit > 0 ? options.duration : 10.0;
+    
+    restrictCpus();
+    if (view()) view()->workloadConfigured(*this, limit);
+    reportPlacement();
+    
+    if (options.distribution == OffsetDistribution::Zipf) zipfTable.init(fileSize / options.blockSize, options.zipfTheta);
+    workerStatsCount = numThreads;
+    workerStats.reset(new WorkerStats[numThreads]);
+    limiter.start();
+    if (view()) view()->running(*this);
+    
+    auto startTime = steady_clock::now();
+    vector<thread> workers;
+    for (int i = 0; i < numThreads; i++) {
+        workers.emplace_back(&TurboFileCreator::workloadWorker, this, i);
+    }
+    
+    double nextReport = options.progressInterval;
+    while (true) {
+        this_thread::sleep_for(milliseconds(50));
+        double elapsed = duration<double>(steady_clock::now() - startTime).count();
+        if (limit > 0 && elapsed >= limit) workloadStop = true;
+        
+        long long reads = 0, writes = 0;
+        for (int i = 0; i < numThreads; i++) {
+            reads += static_cast<long long>(workerStats[i].readLatency.count());
+            writes += static_cast<long long>(workerStats[i].writeLatency.count());
+        }
+        trackWorkload(reads, writes, elapsed, limit);
+        
+        if (headless() && options.progressInterval > 0 && elapsed >= nextReport) {
+            emitRecord(StructuredRecord("progress").addNumber("elapsed_sec", elapsed)
+                                                   .addInt("read_ops", reads)
+                                                   .addInt("write_ops", writes)
+                                                   .addNumber("iops", elapsed > 0 ? (reads + writes) / elapsed : 0, 1));
+            nextReport += options.progressInterval;
+        }
+        if (workloadStop || errorFlag || (options.opLimit > 0 && reads + writes >= options.opLimit)) break;
+    }
+    
+    for (auto& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+    double totalTime = duration<double>(steady_clock::now() - startTime).count();
+    if (view()) view()->stopped(*this);
+    reportPlacement();
+    
+    LatencyHistogram reads, writes;
+    long long readBytes, writeBytes;
+    workloadTotals(reads, writes, readBytes, writeBytes);
+    long long ops = static_cast<long long>(reads.count() + writes.count());
+    
+    if (errorFlag) {
+        reportError(failureReason("I/O error during the workload"));
+    }
+    
+    if (headless()) {
+        StructuredRecord record("workload");
+        record.addText("file", fileName)
+              .addInt("size_bytes", fileSize)
+              .addInt("block_size", options.blockSize)
+              .addInt("read_pct", options.readPercent)
+              .addText("distribution", distributionName(options.distribution, options.zipfTheta))
+              .addInt("workers", numThreads)
+              .addBool("direct_io", options.directIO)
+              .addNumber("elapsed_sec", totalTime, 6)
+              .addInt("ops", ops)
+              .addNumber("iops", totalTime > 0 ? ops / totalTime : 0, 1);
+        addOpFields(record, "read", reads, readBytes, totalTime);
+        addOpFields(record, "write", writes, writeBytes, totalTime);
+        emitRecord(record);
+        return !errorFlag;
+    }
+    
+    if (view()) view()->workloadFinished(*this, totalTime);
+    return !errorFlag;
+    #endif
+}
+
+} // namespace turbo
+
+#endif // TURBO_FILE_CREATOR_WORKLOAD_HPP
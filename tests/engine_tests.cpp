@@ -0,0 +1,262 @@
+// Turbo File Creator engine tests
+// Build and run from the repository root:
+//   g++ -std=c++17 -O2 -Wall -Wextra -pthread tests/engine_tests.cpp -o tests/engine_tests && tests/engine_tests
+// The command line is compiled in as well (its main renamed) so its parsers can be checked.
+#define main fileCreatorMain
+#include "../file_creator.cpp"
+#undef main
+
+namespace {
+
+int failures = 0;
+int checks = 0;
+
+#define CHECK(condition) \
+    do { \
+        checks++; \
+        if (!(condition)) { \
+            failures++; \
+            cerr << "  FAILED " << __FILE__ << ":" << __LINE__ << ": " #condition "\n"; \
+        } \
+    } while (0)
+
+const string scratch = "engine_tests.tmp";
+
+// Runs one creator with JSON records captured, so results only found in the records can be checked
+string captured(const function<void()>& run) {
+    stringstream out;
+    streambuf* previous = cout.rdbuf(out.rdbuf());
+    run();
+    cout.rdbuf(previous);
+    return out.str();
+}
+
+long long recordValue(const string& records, const string& key) {
+    size_t at = records.find("\"" + key + "\":");
+    if (at == string::npos) return LLONG_MIN;
+    return atoll(records.c_str() + at + key.size() + 3);
+}
+
+// Same seed and offset, same bytes: every kernel, any offset, any length
+void testGeneratorDeterminism() {
+    const size_t length = 1 << 20;
+    PatternGenerator scalar(0x1234, PatternGenerator::Scalar);
+    vector<char> reference(length);
+    scalar.fill(reference.data(), length, 0);
+
+    PatternGenerator::Kernel kernels[] = {PatternGenerator::SSE2, PatternGenerator::AVX2};
+    for (PatternGenerator::Kernel kernel : kernels) {
+        PatternGenerator simd(0x1234, kernel);
+        vector<char> block(length);
+        simd.fill(block.data(), length, 0);
+        CHECK(memcmp(block.data(), reference.data(), length) == 0);
+
+        // Unaligned offset and length, into a misaligned destination
+        vector<char> piece(10001 + 1);
+        simd.fill(piece.data() + 1, 10001, 3 * 4096 + 17);
+        CHECK(memcmp(piece.data() + 1, reference.data() + 3 * 4096 + 17, 10001) == 0);
+    }
+
+    // A stored checksum pins the format, so files written by older builds still verify
+    CHECK(Crc32c::compute(reference.data(), 4096) == 0x2A28C319U);
+
+    PatternGenerator other(0x1235, PatternGenerator::Scalar);
+    vector<char> different(4096);
+    other.fill(different.data(), 4096, 0);
+    CHECK(memcmp(different.data(), reference.data(), 4096) != 0);
+
+    vector<char> reseeded(4096);
+    scalar.reseeded(0x1235).fill(reseeded.data(), 4096, 0);
+    CHECK(memcmp(reseeded.data(), different.data(), 4096) == 0);
+
+    // Shaping changes the content the same way on every kernel
+    PatternGenerator shapedScalar(7, PatternGenerator::Scalar);
+    PatternGenerator shapedBest(7);
+    shapedScalar.shape(2.0, 2.0, 16384);
+    shapedBest.shape(2.0, 2.0, 16384);
+    vector<char> a(length), b(length);
+    shapedScalar.fill(a.data(), length, 5 * length);
+    shapedBest.fill(b.data(), length, 5 * length);
+    CHECK(memcmp(a.data(), b.data(), length) == 0);
+}
+
+// A flipped byte fails verification and is reported at its exact offset
+void testVerifyFindsFlippedByte() {
+    CreatorOptions options;
+    options.quiet = false;
+    options.format = OutputFormat::Json;
+    options.seed = 42;
+    long long size = 5 * 1024 * 1024 + 123;
+
+    bool written = false;
+    captured([&] {
+        TurboFileCreator writer(scratch, size, 2, 1, true, false, options);
+        written = writer.execute();
+    });
+    CHECK(written);
+
+    bool clean = false;
+    string records = captured([&] {
+        TurboFileCreator checker(scratch, size, 2, 1, true, false, options);
+        clean = checker.verifyExisting();
+    });
+    CHECK(clean);
+    CHECK(recordValue(records, "first_mismatch") == -1);
+
+    long long flipped = 3 * 1024 * 1024 + 777;
+    {
+        fstream file(scratch, ios::in | ios::out | ios::binary);
+        file.seekg(flipped);
+        char byte = static_cast<char>(file.get());
+        file.seekp(flipped);
+        file.put(static_cast<char>(byte ^ 0x01));
+    }
+
+    bool dirty = true;
+    records = captured([&] {
+        TurboFileCreator checker(scratch, size, 2, 1, true, false, options);
+        dirty = checker.verifyExisting();
+    });
+    CHECK(!dirty);
+    CHECK(recordValue(records, "first_mismatch") == flipped);
+
+    // A different seed describes different content from the first byte
+    options.seed = 43;
+    records = captured([&] {
+        TurboFileCreator checker(scratch, size, 2, 1, true, false, options);
+        checker.verifyExisting();
+    });
+    CHECK(recordValue(records, "first_mismatch") == 0);
+    remove(scratch.c_str());
+}
+
+void testCheckpointRoundTrip() {
+    string path = scratch + ".ckpt";
+    Checkpoint saved;
+    saved.init(path, 1000000, 4096, 99, true);
+    saved.markDone(0);
+    saved.markDone(64);
+    saved.markDone(saved.unitCount() - 1);
+    CHECK(saved.save(saved.snapshot()));
+
+    Checkpoint loaded;
+    string error;
+    CHECK(loaded.load(path, 1000000, 99, true, error));
+    CHECK(loaded.unit() == 4096);
+    CHECK(loaded.isDone(0) && loaded.isDone(64) && loaded.isDone(loaded.unitCount() - 1));
+    CHECK(!loaded.isDone(1) && !loaded.isDone(63));
+    CHECK(loaded.doneBytes() == saved.doneBytes());
+    CHECK(loaded.doneBytes() == 4096 + 4096 + (1000000 - (loaded.unitCount() - 1) * 4096));
+
+    // A checkpoint from another size, seed or data mode is refused
+    Checkpoint foreign;
+    CHECK(!foreign.load(path, 2000000, 99, true, error));
+    CHECK(!foreign.load(path, 1000000, 100, true, error));
+    CHECK(!foreign.load(path, 1000000, 99, false, error));
+
+    {
+        ofstream junk(path, ios::trunc);
+        junk << "not a checkpoint\n";
+    }
+    CHECK(!foreign.load(path, 1000000, 99, true, error));
+    CHECK(error.find("not a checkpoint") != string::npos);
+    remove(path.c_str());
+    CHECK(!foreign.load(path, 1000000, 99, true, error));
+}
+
+void testSchedulerSkipsFinishedUnits() {
+    vector<bool> skip(10, false);
+    skip[0] = skip[3] = skip[9] = true;
+
+    ChunkScheduler scheduler;
+    scheduler.reset(95, 10, &skip);
+    vector<long long> starts;
+    long long start, end;
+    while (scheduler.next(start, end)) {
+        starts.push_back(start);
+        CHECK(end == min(95LL, start + 10));
+    }
+    vector<long long> expected = {10, 20, 40, 50, 60, 70, 80};
+    CHECK(starts == expected);
+    CHECK(scheduler.drained());
+
+    // Without a bitmap the last, short unit is handed out as well
+    scheduler.reset(95, 10);
+    int units = 0;
+    while (scheduler.next(start, end)) units++;
+    CHECK(units == 10);
+}
+
+void testHistogramPercentiles() {
+    LatencyHistogram histogram;
+    CHECK(histogram.percentile(50) == 0);
+    for (uint64_t v = 1; v <= 1000; v++) histogram.record(v);
+
+    CHECK(histogram.count() == 1000);
+    CHECK(histogram.maximum() == 1000);
+    CHECK(histogram.sum() == 500500);
+    // Buckets are 1/16 of a power of two wide and report their upper edge
+    uint64_t p50 = histogram.percentile(50);
+    uint64_t p99 = histogram.percentile(99);
+    CHECK(p50 >= 500 && p50 <= 500 + 500 / 16);
+    CHECK(p99 >= 990 && p99 <= 1000);
+    CHECK(histogram.percentile(100) == 1000);
+
+    LatencyHistogram small;
+    for (uint64_t v = 0; v < 16; v++) small.record(v);
+    CHECK(small.percentile(50) == 7);
+
+    LatencyHistogram merged;
+    merged.merge(histogram);
+    merged.merge(small);
+    CHECK(merged.count() == 1016);
+    CHECK(merged.maximum() == 1000);
+}
+
+void testParsers() {
+    CHECK(parseRateInput("200MB/s") == 200.0 * 1024 * 1024);
+    CHECK(parseRateInput("200 MB/s") == 200.0 * 1024 * 1024);
+    CHECK(parseRateInput("1.5 GB") == 1.5 * 1024 * 1024 * 1024);
+    CHECK(parseRateInput("fast") < 0);
+    CHECK(parseRateInput("10 XB/s") < 0);
+    CHECK(parseRateInput("10 MB per second") < 0);
+
+    BatchPlan plan;
+    CHECK(parseSizeMix("4KB", plan));
+    CHECK(plan.sizeMix.empty() && plan.rangeMin == 4096 && plan.rangeMax == 4096);
+    CHECK(parseSizeMix("4KB-1MB", plan));
+    CHECK(plan.rangeMin == 4096 && plan.rangeMax == 1024 * 1024);
+    CHECK(!parseSizeMix("1MB-4KB", plan));
+    CHECK(parseSizeMix("4KB:70,64KB:25,1MB:5", plan));
+    CHECK(plan.sizeMix.size() == 3);
+    CHECK(plan.sizeMix[1].bytes == 64 * 1024 && plan.sizeMix[2].cumulativeWeight == 100);
+    CHECK(!parseSizeMix("4KB:0", plan));
+
+    vector<int> cpus = CpuTopology::parse("0-3,8,10-11");
+    vector<int> expected = {0, 1, 2, 3, 8, 10, 11};
+    CHECK(cpus == expected);
+    CHECK(CpuTopology::parse("5") == vector<int>{5});
+    CHECK(CpuTopology::parse("").empty());
+    CHECK(CpuTopology::parse("abc").empty());
+    CHECK(CpuTopology::parse("0-x").empty());
+    CHECK(CpuTopology::parse("2x").empty());
+    CHECK(CpuTopology::parse("3-1").empty());
+    CHECK(CpuTopology::parse("-1").empty());
+    CHECK(CpuTopology::parse("0-99999999999999999999").empty());
+    CHECK(CpuTopology::parse("0-" + to_string(CpuTopology::MAX_CPUS)).empty());
+    CHECK(CpuTopology::parse("0-" + to_string(CpuTopology::MAX_CPUS - 1)).size() == static_cast<size_t>(CpuTopology::MAX_CPUS));
+}
+
+} // namespace
+
+int main() {
+    testGeneratorDeterminism();
+    testVerifyFindsFlippedByte();
+    testCheckpointRoundTrip();
+    testSchedulerSkipsFinishedUnits();
+    testHistogramPercentiles();
+    testParsers();
+
+    cout << (failures ? "FAILED: " : "OK: ") << checks - failures << " of " << checks << " checks passed\n";
+    return failures ? 1 : 0;
+}